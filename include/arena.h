@@ -0,0 +1,36 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define ARENA_BLOCK_SIZE 65536
+#define ARENA_ALIGN 8
+
+typedef struct arena_block_struct arena_block;
+
+struct arena_block_struct {
+	arena_block* previous;
+	size_t size;
+	size_t used;
+	uint8_t data[];
+};
+
+typedef struct arena_struct {
+	arena_block* block;
+} arena;
+
+typedef struct arena_mark_struct {
+	arena_block* block;
+	size_t used;
+} arena_mark;
+
+void arena_init(arena* a);
+void arena_del(arena* a);
+void* arena_alloc(arena* a, size_t size);
+arena_mark arena_save(arena* a);
+void arena_reset(arena* a, arena_mark mark);
+
+#endif
\ No newline at end of file
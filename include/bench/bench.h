@@ -0,0 +1,56 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+	#include <direct.h>
+#else
+	#include <sys/resource.h>
+	#include <sys/stat.h>
+#endif
+
+#include "compiler.h"
+
+#define BENCH_IDENTIFIERS_PER_LINE 8
+
+typedef struct bench_options_struct {
+	size_t functions;
+	size_t identifiers;
+	size_t depth;
+	size_t statements;
+	size_t strings;
+	size_t imports;
+	size_t repeat;
+	uint64_t seed;
+	char* dir;
+} bench_options;
+
+typedef struct bench_result_struct {
+	size_t files;
+	size_t bytes;
+	size_t tokens;
+	double total;
+	vector(report_entry) phases;
+} bench_result;
+
+void bench_init(bench_options* options);
+bool bench_parse_number(char* argument, uint64_t* number);
+bool bench_parse_option(bench_options* options, char* option, bool* valid);
+uint64_t bench_random(uint64_t* state);
+void bench_write_statements(FILE* file, bench_options* options, uint64_t* state, size_t module, size_t function, size_t depth);
+bool bench_write_module(bench_options* options, uint64_t* state, size_t module, size_t begin, size_t end);
+bool bench_write_main(bench_options* options);
+bool bench_count(char* filename, bench_result* result);
+bool bench_generate(bench_options* options, bench_result* result);
+size_t bench_peak_rss(void);
+bool bench_run(bench_options* options, char** compiler_options, int compiler_option_count, bool profile, bench_result* result);
+void bench_report(bench_result* result);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef __BYTECODE_H__
+#define __BYTECODE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lz.h"
+#include "opcode.h"
+
+#define BYTECODE_MAGIC "SABR"
+#define BYTECODE_VERSION 3
+#define BYTECODE_HEADER_SIZE 32
+#define BYTECODE_SECTION_ENTRY_SIZE 24
+#define BYTECODE_SECTION_MAX 8
+#define BYTECODE_ALIGN 8
+#define BYTECODE_FUNCTION_ENTRY_SIZE 32
+#define BYTECODE_FUNCTION_TOPLEVEL 0x100
+#define BYTECODE_FLAG_OBJECT 1
+#define SECTION_FLAG_LZ 1
+
+typedef enum bytecode_section_type_enum {
+	SECTION_NONE,
+	SECTION_CODE,
+	SECTION_FUNCTIONS,
+	SECTION_CONSTANTS,
+	SECTION_METADATA,
+	SECTION_DEBUG,
+	SECTION_SYMBOLS,
+	SECTION_RELOCATIONS
+} bytecode_section_type;
+
+typedef struct bytecode_section_struct {
+	uint32_t type;
+	uint32_t flags;
+	uint64_t offset;
+	uint64_t size;
+	const uint8_t* data;
+	uint8_t* buffer;
+} bytecode_section;
+
+typedef struct bytecode_image_struct {
+	uint32_t version;
+	uint32_t section_count;
+	uint32_t flags;
+	uint64_t keyword_count;
+	uint64_t entry;
+	bytecode_section sections[BYTECODE_SECTION_MAX];
+} bytecode_image;
+
+void bytecode_store_u32(uint8_t* out, uint32_t x);
+void bytecode_store_u64(uint8_t* out, uint64_t x);
+uint32_t bytecode_load_u32(const uint8_t* in);
+uint64_t bytecode_load_u64(const uint8_t* in);
+void bytecode_store_width(uint8_t* out, uint64_t x, size_t width);
+uint64_t bytecode_load_width(const uint8_t* in, size_t width);
+int64_t bytecode_load_signed(const uint8_t* in, size_t width);
+size_t bytecode_store_uleb(uint8_t* out, uint64_t x);
+bool bytecode_load_uleb(const uint8_t** in, const uint8_t* end, uint64_t* x);
+uint64_t bytecode_zigzag(int64_t x);
+int64_t bytecode_unzigzag(uint64_t x);
+
+size_t opcode_operand_size(uint8_t op);
+bool opcode_is_relative(uint8_t op);
+bool opcode_is_signed(uint8_t op);
+
+void bytecode_init(bytecode_image* image);
+bool bytecode_add_section(bytecode_image* image, uint32_t type, const uint8_t* data, uint64_t size);
+bytecode_section* bytecode_find_section(bytecode_image* image, uint32_t type);
+bool bytecode_save(bytecode_image* image, FILE* file);
+bool bytecode_parse(bytecode_image* image, const uint8_t* data, size_t size);
+bool bytecode_compress_section(bytecode_section* section);
+bool bytecode_compress(bytecode_image* image);
+bool bytecode_decompress_section(bytecode_section* section);
+bool bytecode_decompress(bytecode_image* image);
+void bytecode_free(bytecode_image* image);
+bool bytecode_debug_names(const uint8_t** in, const uint8_t* end, uint64_t index, const char** name);
+bool bytecode_find_line(bytecode_section* debug, uint64_t offset, const char** file, uint64_t* line, uint64_t* column);
+const char* bytecode_find_keyword(bytecode_section* debug, uint64_t keyword);
+bool bytecode_read_file(const char* filename, uint8_t** data, size_t* size);
+
+#endif
\ No newline at end of file
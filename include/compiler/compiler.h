@@ -9,25 +9,38 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <uchar.h>
 
+#include <pthread.h>
+
 #ifdef _WIN32
+	#include <direct.h>
 #else
 	#include <libgen.h>
+	#include <sys/file.h>
 	#ifdef __linux__
 		#include <linux/limits.h>
 	#endif
+	#ifdef __APPLE__
+		#include <mach-o/dyld.h>
+	#endif
 #endif
 
+#include "arena.h"
+#include "bytecode.h"
 #include "console.h"
+#include "interpreter.h"
 #include "opcode.h"
 #include "rbt.h"
-#include "trie.h"
+#include "dict.h"
 #include "value.h"
 
 #include "compiler_cctl_define.h"
 #include "control.h"
 #include "operation.h"
+#include "report.h"
+#include "scanner.h"
 
 typedef enum string_parse_mode_enum {
 	STR_PARSE_NONE,
@@ -41,40 +54,231 @@ typedef enum comment_parse_mode_enum {
 	CMNT_PARSE_STACK
 } comment_parse_mode;
 
+typedef enum layout_mode_enum {
+	LAYOUT_SOURCE,
+	LAYOUT_STATIC,
+	LAYOUT_PROFILE
+} layout_mode;
+
+struct source_file_struct {
+	char* filename;
+	char* textcode;
+	vector(token) tokens;
+	bool ready;
+	bool prefetched;
+};
+
+typedef struct prefetch_pool_struct {
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_cond_t done;
+	vector(cctl_ptr(source_file))* sources;
+	size_t next;
+	size_t end;
+	size_t failures;
+	bool stop;
+} prefetch_pool;
+
+typedef struct report_struct {
+	vector(report_frame) frames;
+	vector(report_entry) phases;
+	vector(report_entry) files;
+	double clock;
+	size_t footprint;
+	size_t transient;
+} report;
+
+#ifdef _WIN32
+typedef HANDLE cache_lock;
+#else
+typedef int cache_lock;
+#endif
+
+typedef struct compiler_options_struct {
+	size_t specialize_budget;
+	bool merge_functions;
+	bool scratch_alloc;
+	bool object;
+	bool compress;
+	bool debug;
+	size_t jobs;
+	bool release_sources;
+	layout_mode layout;
+	char* profile_filename;
+	char* cache_dir;
+	bool cache_stats;
+	char* program_filename;
+	bool time_report;
+	char* time_report_filename;
+} compiler_options;
+
 typedef struct compiler_struct {
 	vector(cctl_ptr(char)) textcode_vector;
+	vector(size_t) textcode_size_vector;
 	vector(cctl_ptr(char)) filename_vector;
 	vector(cctl_ptr(char)) preproc_tokens_vector;
+	arena arena;
+	vector(cctl_ptr(char)) dependency_vector;
 	vector(size_t) textcode_index_stack;
 	vector(uint8_t) bytecode;
-	vector(cctl_ptr(vector(control_data))) control_data_stack;
-	trie dictionary;
-	trie filename_trie;
+	vector(control_data) control_entries;
+	vector(size_t) control_frames;
+	vector(control_data) control_pending;
+	vector(control_data) switch_cases;
+	vector(control_data) switch_passes;
+	vector(control_data) switch_chains;
+	vector(function_data) function_vector;
+	vector(size_t) keyword_sites;
+	vector(relocation) relocations;
+	size_t relocations_resolved;
+	vector(uint8_t) constants;
+	vector(line_row) line_rows;
+	vector(cctl_ptr(source_file)) sources;
+	dict dictionary;
+	dict filename_dict;
+	dict source_dict;
 	size_t dictionary_keyword_count;
+	size_t keyword_value_pos;
 	size_t line_count;
 	size_t column_count;
+	char* mark_cursor;
+	size_t mark_column;
 	mbstate_t convert_state;
+	report* report;
+	compiler_options options;
 } compiler;
 
 bool compiler_init(compiler* comp);
 bool compiler_del(compiler* comp);
 bool compiler_compile(compiler* comp, char* input_filename, char* output_filename);
+bool compiler_build(compiler* comp, char* input_filename, char* output_filename);
 bool compiler_compile_source(compiler* comp, char* input_filename);
 size_t compiler_load_code(compiler* comp, char* filename);
+char* compiler_map_source(char* filename, size_t* mapped);
+void compiler_unmap_source(char* textcode, size_t mapped);
+void compiler_release_code(compiler* comp, size_t index);
+bool compiler_build_function_table(compiler* comp, vector(uint8_t)* table);
+bool compiler_build_metadata(compiler* comp, vector(uint8_t)* metadata);
+bool compiler_build_debug(compiler* comp, vector(uint8_t)* debug);
+bool compiler_push_uleb(vector(uint8_t)* out, uint64_t x);
 bool compiler_save_code(compiler* comp, char* filename);
+bool compiler_build_object_functions(compiler* comp, vector(uint8_t)* table);
+bool compiler_collect_symbols(dict* d, vector(uint8_t)* names, size_t* offsets);
+bool compiler_build_symbols(compiler* comp, vector(uint8_t)* symbols);
+bool compiler_build_relocations(compiler* comp, vector(uint8_t)* relocations);
+bool compiler_save_object(compiler* comp, char* filename);
+bool compiler_object_file(char* filename);
+bool compiler_import_object(compiler* comp, char* filename);
 bool compiler_tokenize(compiler* comp);
+bool compiler_scan_tokens(char* iterator, vector(token)* tokens);
 bool compiler_parse(compiler* comp, char* begin, char* end);
-bool compiler_parse_word_token(compiler* comp, trie* trie_result);
-bool compiler_parse_control_words(compiler* comp, trie* trie_result);
+bool compiler_mark_source(compiler* comp, char* begin, char* end);
+bool compiler_parse_word_token(compiler* comp, dict_entry* dict_result);
+bool compiler_parse_control_words(compiler* comp, dict_entry* dict_result);
+bool compiler_open_control(compiler* comp, control_data ctrl);
+bool compiler_close_control(compiler* comp);
+bool compiler_push_function(compiler* comp, control_data* ctrl);
+void compiler_close_function(compiler* comp, size_t begin);
+bool compiler_verify_region(compiler* comp, size_t begin, size_t end);
+bool compiler_evaluate_immediate(compiler* comp, size_t begin);
 bool compiler_parse_keyword_value(compiler* comp, char* token);
 bool compiler_parse_zero_begin_num(compiler* comp, char* token, size_t index, bool negate);
 bool compiler_parse_base_n_num(compiler* comp, char* token, size_t index, bool negate, int base);
 bool compiler_parse_num(compiler* comp, char* token);
+bool compiler_decode_string(compiler* comp, char* token, vector(value)* value_reverser);
+void compiler_resolve_filename(compiler* comp, char* filename);
+void compiler_join_filename(char* current_filename, char* token, char* filename);
+bool compiler_embed_file(compiler* comp, char* filename);
+bool compiler_add_dependency(compiler* comp, char* filename);
+bool compiler_push_constant_string(compiler* comp, vector(value)* values, value* offset);
 bool compiler_parse_char(compiler* comp, char* token, bool push_length);
+bool compiler_parse_data(compiler* comp, char* token);
 bool compiler_parsed_num_to_bytecode(compiler* comp, value v);
+bool compiler_emit(compiler* comp, const uint8_t* data, size_t size);
+bool compiler_relocate(compiler* comp, size_t site, size_t target);
+void compiler_resolve_relocations(compiler* comp);
 bool compiler_push_bytecode(compiler* comp, opcode op);
 bool compiler_push_bytecode_with_value(compiler* comp, opcode op, value v);
 bool compiler_push_bytecode_with_null(compiler* comp, opcode op);
 bool compiler_push_preproc_token(compiler* comp, char* token);
 
+bool compiler_parse_option(compiler* comp, char* option);
+
+bool compiler_report_init(compiler* comp);
+void compiler_report_del(compiler* comp);
+double compiler_report_clock(void);
+size_t compiler_report_footprint(compiler* comp);
+void compiler_report_account(compiler* comp, bool measure);
+bool compiler_report_enter(compiler* comp, report_phase phase, size_t file);
+void compiler_report_leave(compiler* comp);
+void compiler_report_scanned(compiler* comp, size_t bytes);
+size_t compiler_report_load_code(compiler* comp, char* filename);
+bool compiler_report_tokenize(compiler* comp);
+bool compiler_report_parse(compiler* comp, char* begin, char* end);
+bool compiler_report_control_words(compiler* comp, dict_entry* dict_result);
+void compiler_report_sum(compiler* comp, size_t file, report_entry* sum);
+bool compiler_report_print(compiler* comp);
+void compiler_report_json_entry(FILE* file, const char* name, report_entry* entry);
+bool compiler_report_save(compiler* comp, char* filename);
+bool compiler_report_output(compiler* comp);
+
+bool compiler_optimize(compiler* comp);
+size_t compiler_find_offset(vector(size_t)* offsets, size_t pos);
+bool compiler_decode(compiler* comp, vector(instruction)* code);
+size_t compiler_literal_run(vector(instruction)* code, size_t begin);
+bool compiler_encode(compiler* comp, vector(instruction)* code);
+bool compiler_encode_lines(compiler* comp, vector(instruction)* code, uint8_t* ops, vector(size_t)* offsets);
+bool compiler_compact(vector(instruction)* code, vector(function_data)* functions);
+void compiler_mark_labels(vector(instruction)* code);
+int compiler_compare_keyword_use(const void* a, const void* b);
+bool compiler_collect_keyword_uses(vector(instruction)* code, vector(keyword_use)* uses);
+size_t compiler_find_keyword_use(vector(keyword_use)* uses, size_t keyword);
+bool compiler_local_keyword(vector(keyword_use)* uses, size_t keyword, function_data* func, bool* read_outside);
+bool compiler_variable_keyword(vector(instruction)* code, vector(keyword_use)* uses, size_t keyword);
+int compiler_compare_function(const void* a, const void* b);
+bool compiler_sort_functions(vector(instruction)* code, vector(function_data)* functions, vector(function_data)* sorted);
+function_data* compiler_find_function(vector(function_data)* sorted, size_t keyword);
+bool compiler_specialize(compiler* comp, vector(instruction)* code);
+bool compiler_prune(vector(instruction)* code, bool* changed);
+bool compiler_scratch_use(vector(instruction)* code, size_t index);
+bool compiler_scratch_candidate(vector(instruction)* code, vector(keyword_use)* uses, function_data* func, size_t index);
+bool compiler_scratch_alloc(compiler* comp, vector(instruction)* code);
+bool compiler_mergeable_function(vector(instruction)* code, function_data* func);
+uint64_t compiler_hash_function(vector(instruction)* code, function_data* func);
+bool compiler_equal_function(vector(instruction)* code, function_data* a, function_data* b);
+int compiler_compare_function_hash(const void* a, const void* b);
+bool compiler_merge_functions(compiler* comp, vector(instruction)* code);
+size_t compiler_find_function_index(vector(function_data)* functions, size_t begin);
+bool compiler_static_hotness(compiler* comp, vector(instruction)* code, double* hotness);
+bool compiler_profile_hotness(compiler* comp, double* hotness);
+bool compiler_layout(compiler* comp, vector(instruction)* code);
+bool compiler_install_functions(compiler* comp, vector(instruction)* code);
+bool compiler_fold(interpreter* inter, vector(instruction)* code, vector(keyword_use)* uses, function_data* func);
+bool compiler_fold_operation(interpreter* inter, uint8_t op, value* args, int arity, value* results, size_t* result_count);
+
+bool compiler_prefetch(compiler* comp, char* input_filename);
+void compiler_prefetch_wait(prefetch_pool* pool, source_file* source);
+void compiler_prefetch_claim(prefetch_pool* pool);
+void* compiler_prefetch_worker(void* argument);
+bool compiler_prefetch_source(source_file* source);
+bool compiler_prefetch_imports(compiler* comp, source_file* source);
+bool compiler_add_source(compiler* comp, char* filename);
+source_file* compiler_find_source(compiler* comp, char* filename);
+char* compiler_read_source(char* filename);
+
+uint64_t compiler_hash_bytes(uint64_t hash, const uint8_t* data, size_t size);
+bool compiler_hash_file(char* filename, uint64_t* hash);
+bool compiler_build_id(compiler* comp, uint64_t* id);
+bool compiler_program_path(char* program, char* path);
+bool compiler_cache_key(compiler* comp, char* input_filename, uint64_t* key);
+bool compiler_cache_fetch(compiler* comp, char* input_filename, char* output_filename);
+bool compiler_cache_store(compiler* comp, char* input_filename, char* output_filename);
+bool compiler_cache_count(compiler* comp, bool hit);
+bool compiler_cache_lock(char* lock_path, cache_lock* lock);
+void compiler_cache_unlock(cache_lock* lock);
+void compiler_cache_warning(compiler* comp, const char* message);
+void compiler_cache_temp_path(compiler* comp, char* temp_path);
+bool compiler_replace_file(char* source_filename, char* target_filename);
+bool compiler_copy_file(char* source_filename, char* target_filename);
+
 #endif
\ No newline at end of file
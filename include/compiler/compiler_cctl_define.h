@@ -8,21 +8,46 @@
 #include "value.h"
 
 #include "control.h"
+#include "optimizer.h"
+#include "report.h"
+#include "scanner.h"
+
+typedef struct source_file_struct source_file;
 
 cctl_ptr_def(char);
 vector_fd(cctl_ptr(char));
 vector_fd(uint8_t);
 vector_fd(control_data);
-cctl_ptr_def(vector(control_data));
-vector_fd(cctl_ptr(vector(control_data)));
-vector_fd(value);
+vector_fd(relocation);
+vector_fd(function_data);
+vector_fd(instruction);
+vector_fd(keyword_use);
+vector_fd(specialization);
+vector_fd(function_hash);
+vector_fd(line_row);
+vector_fd(token);
 vector_fd(size_t);
+vector_fd(uint64_t);
+vector_fd(report_entry);
+vector_fd(report_frame);
+cctl_ptr_def(source_file);
+vector_fd(cctl_ptr(source_file));
 
 vector_imp_h(cctl_ptr(char));
 vector_imp_h(uint8_t);
 vector_imp_h(control_data);
-vector_imp_h(cctl_ptr(vector(control_data)));
-vector_imp_h(value);
+vector_imp_h(relocation);
+vector_imp_h(function_data);
+vector_imp_h(instruction);
+vector_imp_h(keyword_use);
+vector_imp_h(specialization);
+vector_imp_h(function_hash);
+vector_imp_h(line_row);
+vector_imp_h(token);
 vector_imp_h(size_t);
+vector_imp_h(uint64_t);
+vector_imp_h(report_entry);
+vector_imp_h(report_frame);
+vector_imp_h(cctl_ptr(source_file));
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef __CONTROL_H__
 #define __CONTROL_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -18,7 +19,9 @@ typedef enum control_enum {
 	CTRL_FUNC,
 	CTRL_MACRO,
 	CTRL_RETURN,
-	CTRL_IMPORT
+	CTRL_IMPORT,
+	CTRL_IMMEDIATE,
+	CTRL_EMBED
 } control;
 
 extern size_t control_len;
@@ -29,4 +32,18 @@ typedef struct control_data_struct {
 	size_t ctrl;
 } control_data;
 
+typedef struct relocation_struct {
+	size_t site;
+	size_t target;
+} relocation;
+
+typedef struct function_data_struct {
+	size_t keyword;
+	size_t ctrl;
+	size_t begin;
+	size_t end;
+	bool toplevel;
+	bool installed;
+} function_data;
+
 #endif
\ No newline at end of file
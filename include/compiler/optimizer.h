@@ -0,0 +1,73 @@
+#ifndef __OPTIMIZER_H__
+#define __OPTIMIZER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "opcode.h"
+#include "value.h"
+
+#define SPECIALIZE_ARGS_MAX 4
+#define FOLD_ITERATION_MAX 32
+#define FOLD_PENDING_MAX 16
+
+#define SCRATCH_CELLS_MAX 64
+
+#define VALUES_RUN_MIN 4
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+#define LAYOUT_LOOP_WEIGHT 8
+#define LAYOUT_LOOP_DEPTH_MAX 4
+#define LAYOUT_PASS_MAX 8
+#define LAYOUT_HOTNESS_MAX 1e15
+#define LAYOUT_COLD_RATIO 1000
+#define LAYOUT_NAME_MAX 1024
+
+typedef struct instruction_struct {
+	value operand;
+	size_t target;
+	size_t source;
+	uint8_t op;
+	bool keyword;
+	bool label;
+} instruction;
+
+typedef struct line_row_struct {
+	size_t offset;
+	size_t file;
+	size_t line;
+	size_t column;
+} line_row;
+
+typedef struct keyword_use_struct {
+	size_t keyword;
+	size_t index;
+	uint8_t op;
+	bool store;
+} keyword_use;
+
+typedef struct specialization_struct {
+	size_t begin;
+	size_t count;
+	value args[SPECIALIZE_ARGS_MAX];
+	size_t keyword;
+} specialization;
+
+typedef struct function_hash_struct {
+	uint64_t hash;
+	size_t index;
+} function_hash;
+
+bool instruction_has_operand(uint8_t op);
+bool instruction_is_branch(uint8_t op);
+size_t instruction_size(instruction* inst);
+bool instruction_fits(int64_t x, size_t width);
+uint8_t instruction_unsigned_opcode(uint8_t op, uint8_t narrow, uint64_t x);
+uint8_t instruction_compact_opcode(instruction* inst);
+uint8_t instruction_widen_opcode(uint8_t op);
+int instruction_fold_arity(uint8_t op);
+
+#endif
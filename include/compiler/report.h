@@ -0,0 +1,34 @@
+#ifndef __REPORT_H__
+#define __REPORT_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum report_phase_enum {
+	REPORT_OTHER,
+	REPORT_PREFETCH,
+	REPORT_LOAD,
+	REPORT_TOKENIZE,
+	REPORT_PARSE,
+	REPORT_CONTROL,
+	REPORT_OPTIMIZE,
+	REPORT_SAVE
+} report_phase;
+
+extern size_t report_phase_len;
+extern const char* report_phase_names[];
+
+typedef struct report_entry_struct {
+	double time;
+	size_t calls;
+	size_t bytes;
+} report_entry;
+
+typedef struct report_frame_struct {
+	report_phase phase;
+	size_t file;
+	bool measure;
+} report_frame;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef __SCANNER_H__
+#define __SCANNER_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define SCANNER_AVX2
+#endif
+
+#if defined(SCANNER_AVX2) || defined(__SSE2__)
+	#include <immintrin.h>
+#endif
+
+typedef struct token_struct {
+	char* begin;
+	char* end;
+	size_t line;
+	size_t column;
+} token;
+
+bool scanner_special(char c);
+bool scanner_lead(char c);
+#if defined(SCANNER_AVX2)
+__attribute__((target("avx2"))) __m256i scanner_special_avx2(__m256i bytes);
+__attribute__((target("avx2"))) char* scanner_skip_avx2(char* iterator, char* limit, size_t* count);
+#endif
+#if defined(__SSE2__)
+__m128i scanner_special_sse2(__m128i bytes);
+#endif
+char* scanner_skip(char* iterator, char* limit, size_t* columns);
+
+#endif
\ No newline at end of file
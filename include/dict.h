@@ -0,0 +1,40 @@
+#ifndef __DICT_H__
+#define __DICT_H__
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "value.h"
+
+typedef enum word_text_type_enum {
+	WTT_NONE,
+	WTT_OP,
+	WTT_CTRL,
+	WTT_BIF,
+	WTT_KWRD
+} word_text_type;
+
+typedef struct dict_entry_struct {
+	value data;
+	uint64_t hash;
+	uint8_t type;
+	char key[];
+} dict_entry;
+
+typedef struct dict_struct {
+	dict_entry** entries;
+	size_t capacity;
+	size_t size;
+} dict;
+
+void dict_init(dict* d);
+void dict_del(dict* d);
+uint64_t dict_hash(const char* key, size_t* length);
+dict_entry** dict_slot(dict* d, const char* key, uint64_t hash);
+bool dict_grow(dict* d);
+dict_entry* dict_insert(dict* d, const char* key, uint8_t type);
+dict_entry* dict_find(dict* d, const char* key);
+
+#endif
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <locale.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include <uchar.h>
 
 #ifdef _WIN32
@@ -12,33 +13,60 @@
 	#include <io.h>
 	#include <windows.h>
 #else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
 	#include <sys/types.h>
+	#include <unistd.h>
 #endif
 
+#include "bytecode.h"
+#include "console.h"
 #include "opcode.h"
 #include "rbt.h"
+#include "scratch.h"
+#include "verifier.h"
 #include "value.h"
 #include "encoding.h"
 
 #include "interpreter_cctl_define.h"
 
 typedef struct interpreter_struct {
-	uint8_t* bytecode;
+	const uint8_t* bytecode;
 	size_t bytecode_size;
-	deque(value) data_stack;
+	const uint8_t* constants;
+	size_t constants_size;
+	uint8_t* image_data;
+	size_t image_size;
+	bool image_mapped;
+	bytecode_image image;
+	vector(value) data_stack;
 	deque(value) switch_stack;
 	deque(size_t) call_stack;
 	rbt* global_words;
 	deque(cctl_ptr(rbt)) local_words_stack;
+	scratch scratch_region;
+	vector(allocation) allocations;
+	bool track_allocations;
 	mbstate_t convert_state;
 } interpreter;
 
 bool interpreter_init(interpreter* inter);
 void interpreter_del(interpreter* inter);
+bool interpreter_read_code(interpreter* inter, char* filename);
+bool interpreter_map_code(interpreter* inter, char* filename);
 bool interpreter_load_code(interpreter* inter, char* filename);
+bool interpreter_verify(interpreter* inter);
+bool interpreter_install_functions(interpreter* inter);
 bool interpreter_run(interpreter* inter);
+uint64_t interpreter_operand(interpreter* inter, size_t* index, uint8_t op);
+bool interpreter_execute(interpreter* inter, size_t begin, size_t end);
 
+void interpreter_report(interpreter* inter, size_t pos);
 bool interpreter_pop(interpreter* inter, value* v);
 bool interpreter_push(interpreter* inter, value v);
+bool interpreter_push_values(interpreter* inter, const uint8_t* data, size_t count);
+bool interpreter_track_allocation(interpreter* inter, uint64_t* address, size_t size);
+bool interpreter_owns_address(interpreter* inter, value v);
 
 #endif
\ No newline at end of file
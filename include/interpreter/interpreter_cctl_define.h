@@ -4,16 +4,26 @@
 #include <stdint.h>
 
 #include "cctl/deque.h"
+#include "cctl/vector.h"
 
 #include "rbt.h"
 #include "value.h"
 
+typedef struct allocation_struct {
+	uint64_t* address;
+	size_t size;
+} allocation;
+
 cctl_ptr_def(rbt);
 
+vector_fd(value);
+vector_fd(allocation);
 deque_fd(value);
 deque_fd(size_t);
 deque_fd(cctl_ptr(rbt));
 
+vector_imp_h(value);
+vector_imp_h(allocation);
 deque_imp_h(value);
 deque_imp_h(size_t);
 deque_imp_h(cctl_ptr(rbt));
@@ -0,0 +1,41 @@
+#ifndef __SCRATCH_H__
+#define __SCRATCH_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "value.h"
+
+#define SCRATCH_CHUNK_CELLS 4096
+
+typedef struct scratch_chunk_struct scratch_chunk;
+
+struct scratch_chunk_struct {
+	scratch_chunk* next;
+	size_t size;
+	size_t used;
+	value data[];
+};
+
+typedef struct scratch_mark_struct {
+	size_t depth;
+	scratch_chunk* chunk;
+	size_t used;
+} scratch_mark;
+
+typedef struct scratch_struct {
+	scratch_chunk* head;
+	scratch_chunk* current;
+	scratch_mark* marks;
+	size_t mark_count;
+	size_t mark_capacity;
+} scratch;
+
+void scratch_init(scratch* s);
+void scratch_del(scratch* s);
+value* scratch_alloc(scratch* s, size_t count);
+bool scratch_enter(scratch* s, size_t depth);
+void scratch_leave(scratch* s, size_t depth);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef __VERIFIER_H__
+#define __VERIFIER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bytecode.h"
+#include "opcode.h"
+#include "rbt.h"
+#include "value.h"
+
+typedef struct verifier_struct {
+	const uint8_t* code;
+	size_t code_size;
+	size_t base;
+	const uint8_t* constants;
+	size_t constants_size;
+	uint8_t* previous;
+} verifier;
+
+bool verifier_init(verifier* v, const uint8_t* code, size_t code_size, size_t base, const uint8_t* constants, size_t constants_size);
+void verifier_del(verifier* v);
+bool verifier_opcode_valid(uint8_t op);
+uint8_t verifier_branch_kind(uint8_t op);
+bool verifier_boundary(verifier* v, size_t pos);
+bool verifier_operand(verifier* v, size_t pos, uint64_t* operand, size_t* next);
+bool verifier_constant_space(verifier* v, uint64_t offset, size_t unit);
+bool verifier_constant(verifier* v, uint8_t op, uint64_t offset);
+bool verifier_scan(verifier* v);
+bool verifier_check_branches(verifier* v);
+bool verifier_check_function(verifier* v, uint64_t entry, uint64_t end, uint64_t type);
+bool verifier_check_functions(verifier* v, bytecode_section* table);
+bool verifier_run(verifier* v, bytecode_section* table, uint64_t entry);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef __LINKER_H__
+#define __LINKER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bytecode.h"
+#include "compiler.h"
+
+bool linker_add_object(compiler* comp, char* filename);
+bool linker_map_symbols(compiler* comp, bytecode_section* section, uint64_t count, size_t* map);
+bool linker_relocate_code(compiler* comp, size_t code_base, size_t constant_base, size_t* map, uint64_t count);
+bool linker_add_keyword_sites(compiler* comp, bytecode_section* section, size_t code_base, size_t* map, uint64_t count);
+bool linker_add_functions(compiler* comp, bytecode_section* section, size_t code_base, size_t* map, uint64_t count);
+bool linker_link(compiler* comp, char* output_filename);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef __LZ_H__
+#define __LZ_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LZ_HASH_BITS 16
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 65535
+#define LZ_RUN_MASK 15
+
+size_t lz_bound(size_t size);
+uint32_t lz_hash(const uint8_t* p);
+uint8_t* lz_write_length(uint8_t* op, size_t length);
+uint8_t* lz_write_sequence(uint8_t* op, const uint8_t* literals, size_t literal_length, size_t offset, size_t match_length);
+size_t lz_compress(const uint8_t* in, size_t size, uint8_t* out);
+bool lz_read_length(const uint8_t** ip, const uint8_t* end, size_t* length);
+bool lz_decompress(const uint8_t* in, size_t size, uint8_t* out, size_t out_size);
+
+#endif
\ No newline at end of file
@@ -11,11 +11,48 @@ typedef enum opcode_enum {
 	OP_ENDSWITCH,
 	OP_FUNC,
 	OP_MACRO,
+	OP_ALIAS,
 	OP_RETURN,
 	OP_ENDMACRO,
 	OP_TO,
 	OP_CALL,
 
+	OP_VALUE_ZERO,
+	OP_VALUE_ONE,
+	OP_VALUE_8,
+	OP_VALUE_16,
+	OP_VALUE_32,
+	OP_IF_8,
+	OP_IF_16,
+	OP_IF_32,
+	OP_JUMP_8,
+	OP_JUMP_16,
+	OP_JUMP_32,
+	OP_FUNC_8,
+	OP_FUNC_16,
+	OP_FUNC_32,
+	OP_MACRO_8,
+	OP_MACRO_16,
+	OP_MACRO_32,
+	OP_ALIAS_8,
+	OP_ALIAS_16,
+	OP_ALIAS_32,
+	OP_CALL_8,
+	OP_CALL_16,
+	OP_CALL_32,
+	OP_DATA,
+	OP_DATA_8,
+	OP_DATA_16,
+	OP_DATA_32,
+	OP_PUSHDATA,
+	OP_PUSHDATA_8,
+	OP_PUSHDATA_16,
+	OP_PUSHDATA_32,
+	OP_VALUES,
+	OP_VALUES_8,
+	OP_VALUES_16,
+	OP_VALUES_32,
+
 	OP_ADD,
 	OP_SUB,
 	OP_MUL,
@@ -81,6 +118,7 @@ typedef enum opcode_enum {
 
 	OP_FETCH,
 	OP_STORE,
+	OP_SALLOC,
 
 	OP_STOF,
 	OP_UTOF,
@@ -0,0 +1,48 @@
+#include "arena.h"
+
+void arena_init(arena* a) {
+	a->block = NULL;
+}
+
+void arena_del(arena* a) {
+	while (a->block) {
+		arena_block* previous = a->block->previous;
+		free(a->block);
+		a->block = previous;
+	}
+}
+
+void* arena_alloc(arena* a, size_t size) {
+	arena_block* block = a->block;
+	void* result;
+
+	size = (size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+	if (!block || (block->used + size > block->size)) {
+		size_t capacity = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+		block = (arena_block*) malloc(sizeof(arena_block) + capacity);
+		if (!block) return NULL;
+		block->previous = a->block;
+		block->size = capacity;
+		block->used = 0;
+		a->block = block;
+	}
+	result = block->data + block->used;
+	block->used += size;
+	return result;
+}
+
+arena_mark arena_save(arena* a) {
+	arena_mark mark;
+	mark.block = a->block;
+	mark.used = a->block ? a->block->used : 0;
+	return mark;
+}
+
+void arena_reset(arena* a, arena_mark mark) {
+	while (a->block != mark.block) {
+		arena_block* previous = a->block->previous;
+		free(a->block);
+		a->block = previous;
+	}
+	if (a->block) a->block->used = mark.used;
+}
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "bench.h"
+
+void bench_init(bench_options* options) {
+	options->functions = 2000;
+	options->identifiers = 256;
+	options->depth = 3;
+	options->statements = 4;
+	options->strings = 10;
+	options->imports = 8;
+	options->repeat = 3;
+	options->seed = 1;
+	options->dir = "sabrc_bench";
+}
+
+bool bench_parse_number(char* argument, uint64_t* number) {
+	char* stop;
+
+	if (!*argument) return false;
+	errno = 0;
+	*number = strtoull(argument, &stop, 10);
+	return !(errno || *stop);
+}
+
+bool bench_parse_option(bench_options* options, char* option, bool* valid) {
+	char* argument = strchr(option, '=');
+	size_t* target;
+	size_t length;
+	uint64_t number;
+
+	*valid = true;
+	if (!argument) return false;
+	length = argument - option;
+	argument++;
+
+	if (!strncmp(option, "dir", length) && (length == 3)) {
+		options->dir = argument;
+		return true;
+	}
+	if (!strncmp(option, "seed", length) && (length == 4)) {
+		*valid = bench_parse_number(argument, &options->seed);
+		return true;
+	}
+
+	if (!strncmp(option, "functions", length) && (length == 9)) target = &options->functions;
+	else if (!strncmp(option, "identifiers", length) && (length == 11)) target = &options->identifiers;
+	else if (!strncmp(option, "depth", length) && (length == 5)) target = &options->depth;
+	else if (!strncmp(option, "statements", length) && (length == 10)) target = &options->statements;
+	else if (!strncmp(option, "strings", length) && (length == 7)) target = &options->strings;
+	else if (!strncmp(option, "imports", length) && (length == 7)) target = &options->imports;
+	else if (!strncmp(option, "repeat", length) && (length == 6)) target = &options->repeat;
+	else return false;
+
+	*valid = bench_parse_number(argument, &number) && (number <= SIZE_MAX);
+	if (*valid && (target == &options->repeat) && !number) *valid = false;
+	*target = number;
+	return true;
+}
+
+uint64_t bench_random(uint64_t* state) {
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return *state;
+}
+
+void bench_write_statements(FILE* file, bench_options* options, uint64_t* state, size_t module, size_t function, size_t depth) {
+	size_t indent = options->depth - depth + 1;
+
+	for (size_t i = 0; i < options->statements; i++) {
+		size_t target = bench_random(state) % options->identifiers;
+		size_t source = bench_random(state) % options->identifiers;
+
+		for (size_t j = 0; j < indent; j++) fputc('\t', file);
+		if (bench_random(state) % 100 < options->strings) {
+			fprintf(file, "@\"text %" PRIu64 " in m%zu_f%zu\" drop drop\n", bench_random(state) % 1000, module, function);
+		}
+		else if (function && (depth == options->depth) && (i == 0)) {
+			fprintf(file, "a m%zu_f%zu $v%zu to\n", module, function - 1, target);
+		}
+		else {
+			fprintf(file, "v%zu a %zu + * $v%zu to\n", source, (size_t) (bench_random(state) % 100), target);
+		}
+	}
+
+	if (!depth) return;
+
+	for (size_t j = 0; j < indent; j++) fputc('\t', file);
+	if (depth % 2) {
+		fprintf(file, "a %zu > if\n", (size_t) (bench_random(state) % 10));
+		bench_write_statements(file, options, state, module, function, depth - 1);
+		for (size_t j = 0; j < indent; j++) fputc('\t', file);
+		fputs("else\n", file);
+		bench_write_statements(file, options, state, module, function, depth - 1);
+	}
+	else {
+		fputs("loop a 0 > while\n", file);
+		for (size_t j = 0; j <= indent; j++) fputc('\t', file);
+		fputs("a 1 - $a to\n", file);
+		bench_write_statements(file, options, state, module, function, depth - 1);
+	}
+	for (size_t j = 0; j < indent; j++) fputc('\t', file);
+	fputs("end\n", file);
+}
+
+bool bench_write_module(bench_options* options, uint64_t* state, size_t module, size_t begin, size_t end) {
+	char filename[PATH_MAX];
+	FILE* file;
+
+	snprintf(filename, PATH_MAX, "%s/m%zu.sabr", options->dir, module);
+	file = fopen(filename, "w");
+	if (!file) return false;
+
+	for (size_t i = begin; i < end; i++) {
+		fprintf(file, "$m%zu_f%zu func\n\t$a to\n", module, i - begin);
+		bench_write_statements(file, options, state, module, i - begin, options->depth);
+		fprintf(file, "\tv%zu\nend\n\n", (size_t) (bench_random(state) % options->identifiers));
+	}
+
+	return !fclose(file);
+}
+
+bool bench_write_main(bench_options* options) {
+	char filename[PATH_MAX];
+	FILE* file;
+	size_t count = options->functions / options->imports;
+
+	snprintf(filename, PATH_MAX, "%s/main.sabr", options->dir);
+	file = fopen(filename, "w");
+	if (!file) return false;
+
+	for (size_t i = 0; i < options->identifiers; i++) {
+		fprintf(file, "0 $v%zu to", i);
+		fputc(((i + 1) % BENCH_IDENTIFIERS_PER_LINE) ? ' ' : '\n', file);
+	}
+	fputs("\n0 $a to\n", file);
+	for (size_t i = 0; i < options->imports; i++) {
+		fprintf(file, "#m%zu.sabr import\n", i);
+	}
+	for (size_t i = 0; i < options->imports; i++) {
+		size_t last = (i + 1 < options->imports) ? count : options->functions - count * i;
+		if (last) fprintf(file, "3 m%zu_f%zu drop\n", i, last - 1);
+	}
+
+	return !fclose(file);
+}
+
+bool bench_count(char* filename, bench_result* result) {
+	vector(token) tokens;
+	char* textcode = compiler_read_source(filename);
+
+	if (!textcode) return false;
+	vector_init(token, &tokens);
+	if (!compiler_scan_tokens(textcode, &tokens)) {
+		vector_free(token, &tokens);
+		free(textcode);
+		return false;
+	}
+
+	result->files++;
+	result->bytes += strlen(textcode) - 1;
+	result->tokens += tokens.size;
+
+	vector_free(token, &tokens);
+	free(textcode);
+	return true;
+}
+
+bool bench_generate(bench_options* options, bench_result* result) {
+	char filename[PATH_MAX];
+	uint64_t state = options->seed ? options->seed : 1;
+	size_t count;
+
+	if (!options->identifiers || !options->imports) return false;
+	count = options->functions / options->imports;
+
+#ifdef _WIN32
+	_mkdir(options->dir);
+#else
+	mkdir(options->dir, 0755);
+#endif
+
+	if (!bench_write_main(options)) return false;
+	snprintf(filename, PATH_MAX, "%s/main.sabr", options->dir);
+	if (!bench_count(filename, result)) return false;
+
+	for (size_t i = 0; i < options->imports; i++) {
+		size_t end = (i + 1 < options->imports) ? count * (i + 1) : options->functions;
+		if (!bench_write_module(options, &state, i, count * i, end)) return false;
+		snprintf(filename, PATH_MAX, "%s/m%zu.sabr", options->dir, i);
+		if (!bench_count(filename, result)) return false;
+	}
+	return true;
+}
+
+size_t bench_peak_rss(void) {
+#ifdef _WIN32
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage)) return 0;
+	return usage.ru_maxrss;
+#endif
+}
+
+bool bench_run(bench_options* options, char** compiler_options, int compiler_option_count, bool profile, bench_result* result) {
+	compiler comp;
+	char input_filename[PATH_MAX];
+	char output_filename[PATH_MAX];
+	double clock;
+	bool success = false;
+
+	snprintf(input_filename, PATH_MAX, "%s/main.sabr", options->dir);
+	snprintf(output_filename, PATH_MAX, "%s/out.sabre", options->dir);
+
+	if (!compiler_init(&comp)) return false;
+	for (int i = 0; i < compiler_option_count; i++) {
+		if (!compiler_parse_option(&comp, compiler_options[i])) {
+			fprintf(stderr, console_yellow console_bold "--%s" console_reset "\n", compiler_options[i]);
+			fputs("error : Invalid option\n", stderr);
+			goto FAILURE;
+		}
+	}
+
+	if (profile && !compiler_report_init(&comp)) goto FAILURE;
+	clock = compiler_report_clock();
+	if (!compiler_build(&comp, input_filename, output_filename)) goto FAILURE;
+	clock = compiler_report_clock() - clock;
+
+	if (profile) {
+		compiler_report_account(&comp, true);
+		if (!vector_resize(report_entry, &result->phases, report_phase_len)) goto FAILURE;
+		for (size_t i = 0; i < report_phase_len; i++) {
+			*vector_at(report_entry, &result->phases, i) = *vector_at(report_entry, &comp.report->phases, i);
+		}
+	}
+	else result->total = clock;
+	success = true;
+
+FAILURE:
+	compiler_del(&comp);
+	return success;
+}
+
+void bench_report(bench_result* result) {
+	printf("files         %zu\n", result->files);
+	printf("bytes         %zu\n", result->bytes);
+	printf("tokens        %zu\n", result->tokens);
+	for (size_t i = 0; i < result->phases.size; i++) {
+		report_entry* entry = vector_at(report_entry, &result->phases, i);
+		printf("%-13s %.6f s  %zu calls\n", report_phase_names[i], entry->time, entry->calls);
+	}
+	printf("total         %.6f s\n", result->total);
+	printf("tokens/sec    %.0f\n", result->total > 0 ? result->tokens / result->total : 0.0);
+	printf("bytes/sec     %.0f\n", result->total > 0 ? result->bytes / result->total : 0.0);
+	printf("peak rss      %zu KB\n", bench_peak_rss());
+}
\ No newline at end of file
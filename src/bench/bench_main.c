@@ -0,0 +1,57 @@
+#include <stdio.h>
+
+#include "bench.h"
+
+int main(int argc, char* argv[]) {
+
+	bench_options options;
+	bench_result result;
+	double best = 0;
+	char** compiler_options = (char**) malloc(argc * sizeof(char*));
+	int compiler_option_count = 0;
+	bool valid;
+
+	if (!compiler_options) return 1;
+	bench_init(&options);
+	memset(&result, 0, sizeof(result));
+	vector_init(report_entry, &result.phases);
+
+	for (int i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "--", 2)) {
+			fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", argv[i]);
+			fputs("error : Invalid option\n", stderr);
+			return 2;
+		}
+		if (!bench_parse_option(&options, argv[i] + 2, &valid)) compiler_options[compiler_option_count++] = argv[i] + 2;
+		else if (!valid) {
+			fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", argv[i]);
+			fputs("error : Invalid option\n", stderr);
+			return 2;
+		}
+	}
+
+	if (!bench_generate(&options, &result)) {
+		fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", options.dir);
+		fputs("error : Source generation failure\n", stderr);
+		return 3;
+	}
+
+	for (size_t i = 0; i < options.repeat; i++) {
+		if (!bench_run(&options, compiler_options, compiler_option_count, false, &result)) {
+			fputs("error : Compilation failure\n", stderr);
+			return 3;
+		}
+		if (!i || (result.total < best)) best = result.total;
+	}
+	result.total = best;
+	if (!bench_run(&options, compiler_options, compiler_option_count, true, &result)) {
+		fputs("error : Compilation failure\n", stderr);
+		return 3;
+	}
+
+	bench_report(&result);
+	vector_free(report_entry, &result.phases);
+	free(compiler_options);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,425 @@
+#include "bytecode.h"
+
+void bytecode_store_u32(uint8_t* out, uint32_t x) {
+	for (int i = 0; i < 4; i++) {
+		out[i] = (uint8_t) (x >> (i * 8));
+	}
+}
+
+void bytecode_store_u64(uint8_t* out, uint64_t x) {
+	for (int i = 0; i < 8; i++) {
+		out[i] = (uint8_t) (x >> (i * 8));
+	}
+}
+
+uint32_t bytecode_load_u32(const uint8_t* in) {
+	uint32_t x = 0;
+	for (int i = 0; i < 4; i++) {
+		x |= (uint32_t) in[i] << (i * 8);
+	}
+	return x;
+}
+
+uint64_t bytecode_load_u64(const uint8_t* in) {
+	uint64_t x = 0;
+	for (int i = 0; i < 8; i++) {
+		x |= (uint64_t) in[i] << (i * 8);
+	}
+	return x;
+}
+
+void bytecode_store_width(uint8_t* out, uint64_t x, size_t width) {
+	for (size_t i = 0; i < width; i++) {
+		out[i] = (uint8_t) (x >> (i * 8));
+	}
+}
+
+uint64_t bytecode_load_width(const uint8_t* in, size_t width) {
+	uint64_t x = 0;
+	for (size_t i = 0; i < width; i++) {
+		x |= (uint64_t) in[i] << (i * 8);
+	}
+	return x;
+}
+
+int64_t bytecode_load_signed(const uint8_t* in, size_t width) {
+	switch (width) {
+		case 1: {
+			return (int8_t) in[0];
+		}
+		case 2: {
+			return (int16_t) bytecode_load_width(in, 2);
+		}
+		case 4: {
+			return (int32_t) bytecode_load_u32(in);
+		}
+	}
+	return (int64_t) bytecode_load_u64(in);
+}
+
+size_t bytecode_store_uleb(uint8_t* out, uint64_t x) {
+	size_t size = 0;
+	while (x >= 0x80) {
+		out[size++] = (x & 0x7f) | 0x80;
+		x >>= 7;
+	}
+	out[size++] = x;
+	return size;
+}
+
+bool bytecode_load_uleb(const uint8_t** in, const uint8_t* end, uint64_t* x) {
+	int shift = 0;
+	*x = 0;
+	while (*in < end) {
+		uint8_t byte = *(*in)++;
+		if (shift > 63) return false;
+		*x |= (uint64_t) (byte & 0x7f) << shift;
+		if (!(byte & 0x80)) return true;
+		shift += 7;
+	}
+	return false;
+}
+
+uint64_t bytecode_zigzag(int64_t x) {
+	return ((uint64_t) x << 1) ^ (uint64_t) (x >> 63);
+}
+
+int64_t bytecode_unzigzag(uint64_t x) {
+	return (int64_t) (x >> 1) ^ -(int64_t) (x & 1);
+}
+
+size_t opcode_operand_size(uint8_t op) {
+	switch (op) {
+		case OP_VALUE:
+		case OP_IF:
+		case OP_JUMP:
+		case OP_FUNC:
+		case OP_MACRO:
+		case OP_ALIAS:
+		case OP_CALL:
+		case OP_DATA:
+		case OP_PUSHDATA:
+		case OP_VALUES: {
+			return 8;
+		}
+		case OP_VALUE_8:
+		case OP_IF_8:
+		case OP_JUMP_8:
+		case OP_FUNC_8:
+		case OP_MACRO_8:
+		case OP_ALIAS_8:
+		case OP_CALL_8:
+		case OP_DATA_8:
+		case OP_PUSHDATA_8:
+		case OP_VALUES_8: {
+			return 1;
+		}
+		case OP_VALUE_16:
+		case OP_IF_16:
+		case OP_JUMP_16:
+		case OP_FUNC_16:
+		case OP_MACRO_16:
+		case OP_ALIAS_16:
+		case OP_CALL_16:
+		case OP_DATA_16:
+		case OP_PUSHDATA_16:
+		case OP_VALUES_16: {
+			return 2;
+		}
+		case OP_VALUE_32:
+		case OP_IF_32:
+		case OP_JUMP_32:
+		case OP_FUNC_32:
+		case OP_MACRO_32:
+		case OP_ALIAS_32:
+		case OP_CALL_32:
+		case OP_DATA_32:
+		case OP_PUSHDATA_32:
+		case OP_VALUES_32: {
+			return 4;
+		}
+	}
+	return 0;
+}
+
+bool opcode_is_relative(uint8_t op) {
+	return (op >= OP_IF_8) && (op <= OP_ALIAS_32);
+}
+
+bool opcode_is_signed(uint8_t op) {
+	return (op >= OP_VALUE_8) && (op <= OP_ALIAS_32);
+}
+
+void bytecode_init(bytecode_image* image) {
+	image->version = BYTECODE_VERSION;
+	image->section_count = 0;
+	image->flags = 0;
+	image->keyword_count = 0;
+	image->entry = 0;
+}
+
+bool bytecode_add_section(bytecode_image* image, uint32_t type, const uint8_t* data, uint64_t size) {
+	bytecode_section* section;
+	if (image->section_count >= BYTECODE_SECTION_MAX) return false;
+	if (bytecode_find_section(image, type)) return false;
+
+	section = image->sections + image->section_count++;
+	section->type = type;
+	section->flags = 0;
+	section->offset = 0;
+	section->size = size;
+	section->data = data;
+	section->buffer = NULL;
+	return true;
+}
+
+bytecode_section* bytecode_find_section(bytecode_image* image, uint32_t type) {
+	for (uint32_t i = 0; i < image->section_count; i++) {
+		if (image->sections[i].type == type) return image->sections + i;
+	}
+	return NULL;
+}
+
+bool bytecode_save(bytecode_image* image, FILE* file) {
+	uint8_t header[BYTECODE_HEADER_SIZE];
+	uint8_t entry[BYTECODE_SECTION_ENTRY_SIZE];
+	uint8_t padding[BYTECODE_ALIGN];
+	uint64_t offset = BYTECODE_HEADER_SIZE + (uint64_t) image->section_count * BYTECODE_SECTION_ENTRY_SIZE;
+
+	memset(padding, 0, BYTECODE_ALIGN);
+
+	memcpy(header, BYTECODE_MAGIC, 4);
+	bytecode_store_u32(header + 4, image->version);
+	bytecode_store_u32(header + 8, image->section_count);
+	bytecode_store_u32(header + 12, image->flags);
+	bytecode_store_u64(header + 16, image->keyword_count);
+	bytecode_store_u64(header + 24, image->entry);
+	if (fwrite(header, 1, BYTECODE_HEADER_SIZE, file) != BYTECODE_HEADER_SIZE) return false;
+
+	for (uint32_t i = 0; i < image->section_count; i++) {
+		bytecode_section* section = image->sections + i;
+		offset = (offset + BYTECODE_ALIGN - 1) & ~(uint64_t) (BYTECODE_ALIGN - 1);
+		section->offset = offset;
+		offset += section->size;
+
+		bytecode_store_u32(entry, section->type);
+		bytecode_store_u32(entry + 4, section->flags);
+		bytecode_store_u64(entry + 8, section->offset);
+		bytecode_store_u64(entry + 16, section->size);
+		if (fwrite(entry, 1, BYTECODE_SECTION_ENTRY_SIZE, file) != BYTECODE_SECTION_ENTRY_SIZE) return false;
+	}
+
+	offset = BYTECODE_HEADER_SIZE + (uint64_t) image->section_count * BYTECODE_SECTION_ENTRY_SIZE;
+	for (uint32_t i = 0; i < image->section_count; i++) {
+		bytecode_section* section = image->sections + i;
+		size_t gap = section->offset - offset;
+		if (gap && (fwrite(padding, 1, gap, file) != gap)) return false;
+		if (section->size && (fwrite(section->data, 1, section->size, file) != section->size)) return false;
+		offset = section->offset + section->size;
+	}
+	return true;
+}
+
+bool bytecode_parse(bytecode_image* image, const uint8_t* data, size_t size) {
+	uint64_t table_end;
+	uint32_t section_count;
+
+	bytecode_init(image);
+	if (size < BYTECODE_HEADER_SIZE) return false;
+	if (memcmp(data, BYTECODE_MAGIC, 4)) return false;
+
+	image->version = bytecode_load_u32(data + 4);
+	section_count = bytecode_load_u32(data + 8);
+	image->flags = bytecode_load_u32(data + 12);
+	image->keyword_count = bytecode_load_u64(data + 16);
+	image->entry = bytecode_load_u64(data + 24);
+	if (image->version != BYTECODE_VERSION) return false;
+	if (section_count > BYTECODE_SECTION_MAX) return false;
+
+	table_end = BYTECODE_HEADER_SIZE + (uint64_t) section_count * BYTECODE_SECTION_ENTRY_SIZE;
+	if (table_end > size) return false;
+
+	for (uint32_t i = 0; i < section_count; i++) {
+		const uint8_t* entry = data + BYTECODE_HEADER_SIZE + i * BYTECODE_SECTION_ENTRY_SIZE;
+		bytecode_section* section = image->sections + i;
+		section->type = bytecode_load_u32(entry);
+		section->flags = bytecode_load_u32(entry + 4);
+		section->offset = bytecode_load_u64(entry + 8);
+		section->size = bytecode_load_u64(entry + 16);
+		if ((section->offset < table_end) || (section->offset > size)) return false;
+		if (section->size > size - section->offset) return false;
+		for (uint32_t j = 0; j < i; j++) {
+			if (image->sections[j].type == section->type) return false;
+		}
+		section->data = data + section->offset;
+		section->buffer = NULL;
+		image->section_count = i + 1;
+	}
+
+	bytecode_section* code = bytecode_find_section(image, SECTION_CODE);
+	if (!code) return false;
+	if (!(code->flags & SECTION_FLAG_LZ) && (image->entry > code->size)) return false;
+	return true;
+}
+
+bool bytecode_compress_section(bytecode_section* section) {
+	uint8_t* buffer;
+	size_t size;
+
+	if (section->size < 2 * sizeof(uint64_t)) return true;
+	buffer = (uint8_t*) malloc(sizeof(uint64_t) + lz_bound(section->size));
+	if (!buffer) return false;
+
+	size = lz_compress(section->data, section->size, buffer + sizeof(uint64_t));
+	if (!size) {
+		free(buffer);
+		return false;
+	}
+	if (sizeof(uint64_t) + size >= section->size) {
+		free(buffer);
+		return true;
+	}
+
+	bytecode_store_u64(buffer, section->size);
+	free(section->buffer);
+	section->buffer = buffer;
+	section->data = buffer;
+	section->size = sizeof(uint64_t) + size;
+	section->flags |= SECTION_FLAG_LZ;
+	return true;
+}
+
+bool bytecode_compress(bytecode_image* image) {
+	for (uint32_t i = 0; i < image->section_count; i++) {
+		if (!bytecode_compress_section(image->sections + i)) return false;
+	}
+	return true;
+}
+
+bool bytecode_decompress_section(bytecode_section* section) {
+	uint8_t* buffer;
+	uint64_t size;
+
+	if (!(section->flags & SECTION_FLAG_LZ)) return true;
+	if (section->size < sizeof(uint64_t)) return false;
+	size = bytecode_load_u64(section->data);
+	if (size / 256 > section->size) return false;
+
+	buffer = (uint8_t*) malloc(size ? size : 1);
+	if (!buffer) return false;
+	if (!lz_decompress(section->data + sizeof(uint64_t), section->size - sizeof(uint64_t), buffer, size)) {
+		free(buffer);
+		return false;
+	}
+
+	free(section->buffer);
+	section->buffer = buffer;
+	section->data = buffer;
+	section->size = size;
+	section->flags &= ~SECTION_FLAG_LZ;
+	return true;
+}
+
+bool bytecode_decompress(bytecode_image* image) {
+	for (uint32_t i = 0; i < image->section_count; i++) {
+		if (image->sections[i].type == SECTION_DEBUG) continue;
+		if (!bytecode_decompress_section(image->sections + i)) return false;
+	}
+	return image->entry <= bytecode_find_section(image, SECTION_CODE)->size;
+}
+
+void bytecode_free(bytecode_image* image) {
+	for (uint32_t i = 0; i < image->section_count; i++) {
+		free(image->sections[i].buffer);
+		image->sections[i].buffer = NULL;
+	}
+}
+
+bool bytecode_debug_names(const uint8_t** in, const uint8_t* end, uint64_t index, const char** name) {
+	uint64_t count;
+
+	if (!bytecode_load_uleb(in, end, &count)) return false;
+	for (uint64_t i = 0; i < count; i++) {
+		const uint8_t* terminator = (const uint8_t*) memchr(*in, 0, end - *in);
+		if (!terminator) return false;
+		if (i == index) *name = (const char*) *in;
+		*in = terminator + 1;
+	}
+	return true;
+}
+
+bool bytecode_find_line(bytecode_section* debug, uint64_t offset, const char** file, uint64_t* line, uint64_t* column) {
+	const uint8_t* in = debug->data;
+	const uint8_t* end = debug->data + debug->size;
+	const uint8_t* files = in;
+	const char* name = NULL;
+	uint64_t count;
+	uint64_t row_offset = 0;
+	uint64_t row_file = 0;
+	int64_t row_line = 0;
+	bool found = false;
+
+	if (!bytecode_debug_names(&in, end, UINT64_MAX, &name)) return false;
+	if (!bytecode_debug_names(&in, end, UINT64_MAX, &name)) return false;
+	if (!bytecode_load_uleb(&in, end, &count)) return false;
+
+	for (uint64_t i = 0; i < count; i++) {
+		uint64_t delta;
+		uint64_t next_file;
+		uint64_t line_delta;
+		uint64_t next_column;
+		if (!bytecode_load_uleb(&in, end, &delta)) return false;
+		if (!bytecode_load_uleb(&in, end, &next_file)) return false;
+		if (!bytecode_load_uleb(&in, end, &line_delta)) return false;
+		if (!bytecode_load_uleb(&in, end, &next_column)) return false;
+		row_offset += delta;
+		row_line += bytecode_unzigzag(line_delta);
+		if (row_offset > offset) break;
+		row_file = next_file;
+		*line = row_line;
+		*column = next_column;
+		found = true;
+	}
+	if (!found) return false;
+
+	if (!bytecode_debug_names(&files, end, row_file, &name)) return false;
+	*file = name;
+	return name != NULL;
+}
+
+const char* bytecode_find_keyword(bytecode_section* debug, uint64_t keyword) {
+	const uint8_t* in = debug->data;
+	const uint8_t* end = debug->data + debug->size;
+	const char* name = NULL;
+
+	if (!keyword) return NULL;
+	if (!bytecode_debug_names(&in, end, UINT64_MAX, &name)) return NULL;
+	if (!bytecode_debug_names(&in, end, keyword - 1, &name)) return NULL;
+	return name;
+}
+
+bool bytecode_read_file(const char* filename, uint8_t** data, size_t* size) {
+	FILE* file;
+	long length;
+
+	file = fopen(filename, "rb");
+	if (!file) return false;
+	if (fseek(file, 0, SEEK_END)) goto FAILURE;
+	length = ftell(file);
+	if (length < 0) goto FAILURE;
+	rewind(file);
+
+	*data = (uint8_t*) malloc(length ? length : 1);
+	if (!*data) goto FAILURE;
+	if (length && (fread(*data, length, 1, file) != 1)) {
+		free(*data);
+		goto FAILURE;
+	}
+	fclose(file);
+	*size = length;
+	return true;
+
+FAILURE:
+	fclose(file);
+	return false;
+}
\ No newline at end of file
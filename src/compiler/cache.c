@@ -0,0 +1,317 @@
+#include "compiler.h"
+
+uint64_t compiler_hash_bytes(uint64_t hash, const uint8_t* data, size_t size) {
+	for (size_t i = 0; i < size; i++) {
+		hash = (hash ^ data[i]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+bool compiler_hash_file(char* filename, uint64_t* hash) {
+	uint8_t* data;
+	size_t size;
+
+	if (!bytecode_read_file(filename, &data, &size)) return false;
+	*hash = compiler_hash_bytes(FNV_OFFSET_BASIS, data, size);
+	*hash = compiler_hash_bytes(*hash, (const uint8_t*) &size, sizeof(size));
+	free(data);
+	return true;
+}
+
+bool compiler_build_id(compiler* comp, uint64_t* id) {
+	char filename[PATH_MAX];
+
+#if defined(_WIN32)
+	DWORD length = GetModuleFileNameA(NULL, filename, PATH_MAX);
+	if (length && (length < PATH_MAX) && compiler_hash_file(filename, id)) return true;
+#elif defined(__APPLE__)
+	uint32_t length = PATH_MAX;
+	if (!_NSGetExecutablePath(filename, &length) && compiler_hash_file(filename, id)) return true;
+#else
+	if (compiler_hash_file("/proc/self/exe", id)) return true;
+#endif
+	if (!compiler_program_path(comp->options.program_filename, filename)) return false;
+	return compiler_hash_file(filename, id);
+}
+
+bool compiler_program_path(char* program, char* path) {
+#ifdef _WIN32
+	const char* separator = ";";
+#else
+	const char* separator = ":";
+#endif
+	char candidate[PATH_MAX];
+	char* directory;
+
+	if (!program) return false;
+	if (strchr(program, '/') || strchr(program, '\\')) {
+#ifdef _WIN32
+		return _fullpath(path, program, PATH_MAX);
+#else
+		return realpath(program, path);
+#endif
+	}
+
+	directory = getenv("PATH");
+	while (directory && *directory) {
+		size_t length = strcspn(directory, separator);
+		if (length + strlen(program) + 2 <= PATH_MAX) {
+			snprintf(candidate, PATH_MAX, "%.*s/%s", (int) length, directory, program);
+#ifdef _WIN32
+			if (_fullpath(path, candidate, PATH_MAX) && !_access(path, 0)) return true;
+#else
+			if (realpath(candidate, path) && !access(path, X_OK)) return true;
+#endif
+		}
+		directory += length;
+		if (*directory) directory++;
+	}
+	return false;
+}
+
+bool compiler_cache_key(compiler* comp, char* input_filename, uint64_t* key) {
+	char filename_full[PATH_MAX];
+	uint64_t build_id;
+	uint64_t options[8];
+
+#ifdef _WIN32
+	if (!(_fullpath(filename_full, input_filename, PATH_MAX))) return false;
+#else
+	if (!(realpath(input_filename, filename_full))) return false;
+#endif
+
+	if (!compiler_build_id(comp, &build_id)) return false;
+
+	options[0] = BYTECODE_VERSION;
+	options[1] = comp->options.specialize_budget;
+	options[2] = comp->options.merge_functions;
+	options[3] = comp->options.scratch_alloc;
+	options[4] = comp->options.object;
+	options[5] = comp->options.compress;
+	options[6] = comp->options.debug;
+	options[7] = comp->options.layout;
+
+	*key = compiler_hash_bytes(FNV_OFFSET_BASIS, (const uint8_t*) &build_id, sizeof(build_id));
+	*key = compiler_hash_bytes(*key, (const uint8_t*) options, sizeof(options));
+	*key = compiler_hash_bytes(*key, (const uint8_t*) filename_full, strlen(filename_full) + 1);
+	return true;
+}
+
+bool compiler_cache_fetch(compiler* comp, char* input_filename, char* output_filename) {
+	char path[PATH_MAX];
+	char line[PATH_MAX + 32];
+	unsigned long long result;
+	unsigned long long expected;
+	uint64_t key;
+	uint64_t hash;
+	FILE* manifest;
+	char* filename;
+
+	if (!compiler_cache_key(comp, input_filename, &key)) return false;
+
+	snprintf(path, PATH_MAX, "%s/%016" PRIx64 ".manifest", comp->options.cache_dir, key);
+	manifest = fopen(path, "r");
+	if (!manifest) return false;
+
+	if (!fgets(line, sizeof(line), manifest) || (sscanf(line, "result %llx", &result) != 1)) goto MISS;
+	while (fgets(line, sizeof(line), manifest)) {
+		line[strcspn(line, "\n")] = 0;
+		filename = strchr(line, ' ');
+		if (!filename) goto MISS;
+		*filename++ = 0;
+		expected = strtoull(line, NULL, 16);
+		if (!compiler_hash_file(filename, &hash)) goto MISS;
+		if (hash != expected) goto MISS;
+	}
+	fclose(manifest);
+
+	snprintf(path, PATH_MAX, "%s/%016llx.out", comp->options.cache_dir, result);
+	return compiler_copy_file(path, output_filename);
+
+MISS:
+	fclose(manifest);
+	return false;
+}
+
+bool compiler_cache_store(compiler* comp, char* input_filename, char* output_filename) {
+	char path[PATH_MAX];
+	char temp_path[PATH_MAX];
+	vector(cctl_ptr(char)) filenames;
+	vector(uint64_t) hashes;
+	uint64_t key;
+	uint64_t result;
+	FILE* manifest;
+
+	vector_init(cctl_ptr(char), &filenames);
+	vector_init(uint64_t, &hashes);
+
+	if (!compiler_cache_key(comp, input_filename, &key)) goto FAILURE;
+	for (size_t i = 0; i < comp->filename_vector.size; i++) {
+		if (!vector_push_back(cctl_ptr(char), &filenames, *vector_at(cctl_ptr(char), &comp->filename_vector, i))) goto FAILURE;
+	}
+	for (size_t i = 0; i < comp->dependency_vector.size; i++) {
+		if (!vector_push_back(cctl_ptr(char), &filenames, *vector_at(cctl_ptr(char), &comp->dependency_vector, i))) goto FAILURE;
+	}
+	if (comp->options.profile_filename) {
+		if (!vector_push_back(cctl_ptr(char), &filenames, comp->options.profile_filename)) goto FAILURE;
+	}
+
+	result = key;
+	for (size_t i = 0; i < filenames.size; i++) {
+		char* filename = *vector_at(cctl_ptr(char), &filenames, i);
+		uint64_t hash;
+		if (!compiler_hash_file(filename, &hash)) goto FAILURE;
+		if (!vector_push_back(uint64_t, &hashes, hash)) goto FAILURE;
+		result = compiler_hash_bytes(result, (const uint8_t*) &hash, sizeof(hash));
+		result = compiler_hash_bytes(result, (const uint8_t*) filename, strlen(filename) + 1);
+	}
+
+#ifdef _WIN32
+	_mkdir(comp->options.cache_dir);
+#else
+	mkdir(comp->options.cache_dir, 0755);
+#endif
+
+	compiler_cache_temp_path(comp, temp_path);
+	snprintf(path, PATH_MAX, "%s/%016" PRIx64 ".out", comp->options.cache_dir, result);
+	if (!compiler_copy_file(output_filename, temp_path)) goto FAILURE;
+	if (!compiler_replace_file(temp_path, path)) goto FAILURE;
+
+	snprintf(path, PATH_MAX, "%s/%016" PRIx64 ".manifest", comp->options.cache_dir, key);
+	manifest = fopen(temp_path, "w");
+	if (!manifest) goto FAILURE;
+	fprintf(manifest, "result %016" PRIx64 "\n", result);
+	for (size_t i = 0; i < filenames.size; i++) {
+		fprintf(manifest, "%016" PRIx64 " %s\n", *vector_at(uint64_t, &hashes, i), *vector_at(cctl_ptr(char), &filenames, i));
+	}
+	if (fclose(manifest)) goto FAILURE;
+	if (!compiler_replace_file(temp_path, path)) goto FAILURE;
+
+	vector_free(cctl_ptr(char), &filenames);
+	vector_free(uint64_t, &hashes);
+	return true;
+
+FAILURE:
+	vector_free(cctl_ptr(char), &filenames);
+	vector_free(uint64_t, &hashes);
+	return false;
+}
+
+bool compiler_cache_count(compiler* comp, bool hit) {
+	char path[PATH_MAX];
+	char temp_path[PATH_MAX];
+	char lock_path[PATH_MAX];
+	size_t hits = 0;
+	size_t misses = 0;
+	cache_lock lock;
+	bool locked;
+	bool result = false;
+	FILE* file;
+
+	snprintf(path, PATH_MAX, "%s/stats", comp->options.cache_dir);
+	snprintf(lock_path, PATH_MAX, "%s/lock", comp->options.cache_dir);
+	compiler_cache_temp_path(comp, temp_path);
+	locked = compiler_cache_lock(lock_path, &lock);
+
+	file = fopen(path, "r");
+	if (file) {
+		if (fscanf(file, "hits %zu misses %zu", &hits, &misses) != 2) {
+			hits = 0;
+			misses = 0;
+		}
+		fclose(file);
+	}
+
+	if (hit) hits++;
+	else misses++;
+
+	file = fopen(temp_path, "w");
+	if (!file) goto END;
+	fprintf(file, "hits %zu misses %zu\n", hits, misses);
+	if (fclose(file)) goto END;
+	if (!compiler_replace_file(temp_path, path)) goto END;
+
+	if (comp->options.cache_stats) {
+		printf("cache %s : %zu hits, %zu misses\n", hit ? "hit" : "miss", hits, misses);
+	}
+	result = true;
+
+END:
+	if (locked) compiler_cache_unlock(&lock);
+	return result;
+}
+
+bool compiler_cache_lock(char* lock_path, cache_lock* lock) {
+#ifdef _WIN32
+	OVERLAPPED overlapped = {0};
+
+	*lock = CreateFileA(lock_path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (*lock == INVALID_HANDLE_VALUE) return false;
+	if (LockFileEx(*lock, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped)) return true;
+	CloseHandle(*lock);
+	return false;
+#else
+	*lock = open(lock_path, O_RDWR | O_CREAT, 0644);
+	if (*lock < 0) return false;
+	while (flock(*lock, LOCK_EX)) {
+		if (errno != EINTR) {
+			close(*lock);
+			return false;
+		}
+	}
+	return true;
+#endif
+}
+
+void compiler_cache_unlock(cache_lock* lock) {
+#ifdef _WIN32
+	OVERLAPPED overlapped = {0};
+
+	UnlockFileEx(*lock, 0, 1, 0, &overlapped);
+	CloseHandle(*lock);
+#else
+	close(*lock);
+#endif
+}
+
+void compiler_cache_warning(compiler* comp, const char* message) {
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", comp->options.cache_dir);
+	fprintf(stderr, "warning : %s\n", message);
+}
+
+void compiler_cache_temp_path(compiler* comp, char* temp_path) {
+#ifdef _WIN32
+	unsigned long id = GetCurrentProcessId();
+#else
+	unsigned long id = getpid();
+#endif
+	snprintf(temp_path, PATH_MAX, "%s/%lu.tmp", comp->options.cache_dir, id);
+}
+
+bool compiler_replace_file(char* source_filename, char* target_filename) {
+#ifdef _WIN32
+	if (MoveFileExA(source_filename, target_filename, MOVEFILE_REPLACE_EXISTING)) return true;
+#else
+	if (!rename(source_filename, target_filename)) return true;
+#endif
+	remove(source_filename);
+	return false;
+}
+
+bool compiler_copy_file(char* source_filename, char* target_filename) {
+	uint8_t* data;
+	size_t size;
+	FILE* file;
+	bool result;
+
+	if (!bytecode_read_file(source_filename, &data, &size)) return false;
+	file = fopen(target_filename, "wb");
+	if (!file) {
+		free(data);
+		return false;
+	}
+	result = !size || (fwrite(data, size, 1, file) == 1);
+	result = !fclose(file) && result;
+	free(data);
+	return result;
+}
\ No newline at end of file
@@ -4,28 +4,64 @@ bool compiler_init(compiler* comp) {
 	setlocale(LC_ALL, "en_US.utf8");
 
 	vector_init(cctl_ptr(char), &comp->textcode_vector);
+	vector_init(size_t, &comp->textcode_size_vector);
 	vector_init(cctl_ptr(char), &comp->filename_vector);
 	vector_init(cctl_ptr(char), &comp->preproc_tokens_vector);
+	arena_init(&comp->arena);
+	vector_init(cctl_ptr(char), &comp->dependency_vector);
 	vector_init(size_t, &comp->textcode_index_stack);
 	vector_init(uint8_t, &comp->bytecode);
-	vector_init(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-	trie_init(&comp->dictionary);
-	trie_init(&comp->filename_trie);
+	vector_init(control_data, &comp->control_entries);
+	vector_init(size_t, &comp->control_frames);
+	vector_init(control_data, &comp->control_pending);
+	vector_init(control_data, &comp->switch_cases);
+	vector_init(control_data, &comp->switch_passes);
+	vector_init(control_data, &comp->switch_chains);
+	vector_init(function_data, &comp->function_vector);
+	vector_init(size_t, &comp->keyword_sites);
+	vector_init(relocation, &comp->relocations);
+	vector_init(uint8_t, &comp->constants);
+	vector_init(line_row, &comp->line_rows);
+	vector_init(cctl_ptr(source_file), &comp->sources);
+	dict_init(&comp->dictionary);
+	dict_init(&comp->filename_dict);
+	dict_init(&comp->source_dict);
 
 	comp->dictionary_keyword_count = 0;
+	comp->keyword_value_pos = SIZE_MAX;
+	comp->relocations_resolved = 0;
 	comp->line_count = 1;
 	comp->column_count = 0;
-
-	trie* word;
+	comp->mark_cursor = NULL;
+	comp->mark_column = 1;
+	comp->report = NULL;
+
+	comp->options.specialize_budget = 0;
+	comp->options.merge_functions = false;
+	comp->options.scratch_alloc = false;
+	comp->options.object = false;
+	comp->options.compress = false;
+	comp->options.debug = false;
+	comp->options.jobs = 1;
+	comp->options.release_sources = false;
+	comp->options.layout = LAYOUT_SOURCE;
+	comp->options.profile_filename = NULL;
+	comp->options.cache_dir = NULL;
+	comp->options.cache_stats = false;
+	comp->options.program_filename = NULL;
+	comp->options.time_report = false;
+	comp->options.time_report_filename = NULL;
+
+	dict_entry* word;
 
 	for (int i = 0; i < control_len; i++) {
-		word = trie_insert(&comp->dictionary, control_names[i], WTT_CTRL);
+		word = dict_insert(&comp->dictionary, control_names[i], WTT_CTRL);
 		if (!word) goto FAILURE_DICT;
 		word->data.u = i;
 	}
 
 	for (int i = 0; i < operation_len; i++) {
-		word = trie_insert(&comp->dictionary, operation_names[i], WTT_OP);
+		word = dict_insert(&comp->dictionary, operation_names[i], WTT_OP);
 		if (!word) goto FAILURE_DICT;
 		word->data.u = operation_indices[i];
 	}
@@ -39,32 +75,162 @@ FAILURE_DICT:
 
 bool compiler_del(compiler* comp) {
 	for (size_t i = 0; i < comp->textcode_vector.size; i++) {
-		free(*vector_at(cctl_ptr(char), &comp->textcode_vector, i));
+		compiler_release_code(comp, i);
 		free(*vector_at(cctl_ptr(char), &comp->filename_vector, i));
 	}
 
-	for (size_t i = 0; i < comp->preproc_tokens_vector.size; i++) {
-		free(*vector_at(cctl_ptr(char), &comp->preproc_tokens_vector, i));
+	for (size_t i = 0; i < comp->dependency_vector.size; i++) {
+		free(*vector_at(cctl_ptr(char), &comp->dependency_vector, i));
 	}
 
 	vector_free(cctl_ptr(char), &comp->textcode_vector);
+	vector_free(size_t, &comp->textcode_size_vector);
 	vector_free(cctl_ptr(char), &comp->filename_vector);
+	vector_free(cctl_ptr(char), &comp->dependency_vector);
+	vector_free(cctl_ptr(char), &comp->preproc_tokens_vector);
+	arena_del(&comp->arena);
 
 	vector_free(size_t, &comp->textcode_index_stack);
 	vector_free(uint8_t, &comp->bytecode);
-	for (size_t i = 0; i < comp->control_data_stack.size; i++) {
-		vector_free(control_data, *vector_at(cctl_ptr(vector(control_data)), &comp->control_data_stack, i));
+	vector_free(control_data, &comp->control_entries);
+	vector_free(size_t, &comp->control_frames);
+	vector_free(control_data, &comp->control_pending);
+	vector_free(control_data, &comp->switch_cases);
+	vector_free(control_data, &comp->switch_passes);
+	vector_free(control_data, &comp->switch_chains);
+	vector_free(function_data, &comp->function_vector);
+	vector_free(size_t, &comp->keyword_sites);
+	vector_free(relocation, &comp->relocations);
+	vector_free(uint8_t, &comp->constants);
+	vector_free(line_row, &comp->line_rows);
+	for (size_t i = 0; i < comp->sources.size; i++) {
+		source_file* source = *vector_at(cctl_ptr(source_file), &comp->sources, i);
+		free(source->filename);
+		free(source->textcode);
+		vector_free(token, &source->tokens);
+		free(source);
 	}
-	vector_free(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-	trie_del(&comp->dictionary);
-	trie_del(&comp->filename_trie);
+	vector_free(cctl_ptr(source_file), &comp->sources);
+	dict_del(&comp->dictionary);
+	dict_del(&comp->filename_dict);
+	dict_del(&comp->source_dict);
+	compiler_report_del(comp);
+
+	return true;
+}
+
+bool compiler_parse_option(compiler* comp, char* option) {
+	char* argument = strchr(option, '=');
+	char* stop;
+
+	if (argument) *argument++ = 0;
+
+	if (!strcmp(option, "specialize-budget")) {
+		if (!argument) return false;
+		errno = 0;
+		comp->options.specialize_budget = strtoull(argument, &stop, 10);
+		if (errno || *stop) return false;
+	}
+	else if (!strcmp(option, "merge-functions")) {
+		if (argument) return false;
+		comp->options.merge_functions = true;
+	}
+	else if (!strcmp(option, "scratch-alloc")) {
+		if (argument) return false;
+		comp->options.scratch_alloc = true;
+	}
+	else if (!strcmp(option, "compress")) {
+		if (argument) return false;
+		comp->options.compress = true;
+	}
+	else if (!strcmp(option, "cache")) {
+		if (!argument) return false;
+		comp->options.cache_dir = argument;
+	}
+	else if (!strcmp(option, "cache-stats")) {
+		if (argument) return false;
+		comp->options.cache_stats = true;
+	}
+	else if (!strcmp(option, "time-report")) {
+		comp->options.time_report = true;
+		comp->options.time_report_filename = argument;
+	}
+	else if (!strcmp(option, "release-sources")) {
+		if (argument) return false;
+		comp->options.release_sources = true;
+	}
+	else if (!strcmp(option, "jobs")) {
+		if (!argument) return false;
+		errno = 0;
+		comp->options.jobs = strtoull(argument, &stop, 10);
+		if (errno || *stop || !comp->options.jobs) return false;
+	}
+	else if (!strcmp(option, "layout")) {
+		if (!argument) return false;
+		if (!strcmp(argument, "source")) comp->options.layout = LAYOUT_SOURCE;
+		else if (!strcmp(argument, "static")) comp->options.layout = LAYOUT_STATIC;
+		else return false;
+	}
+	else if (!strcmp(option, "profile")) {
+		if (!argument) return false;
+		comp->options.layout = LAYOUT_PROFILE;
+		comp->options.profile_filename = argument;
+	}
+	else return false;
 
 	return true;
 }
 
 bool compiler_compile(compiler* comp, char* input_filename, char* output_filename) {
+	if (comp->options.time_report && !compiler_report_init(comp)) return false;
+	if (comp->options.cache_dir && compiler_cache_fetch(comp, input_filename, output_filename)) {
+		if (!compiler_cache_count(comp, true)) compiler_cache_warning(comp, "Cache statistics failure");
+	}
+	else {
+		if (!compiler_build(comp, input_filename, output_filename)) return false;
+		if (comp->options.cache_dir) {
+			if (!compiler_cache_store(comp, input_filename, output_filename)) compiler_cache_warning(comp, "Cache saving failure, the output is not cached");
+			if (!compiler_cache_count(comp, false)) compiler_cache_warning(comp, "Cache statistics failure");
+		}
+	}
+	if (comp->report && !compiler_report_output(comp)) return false;
+	return true;
+}
+
+bool compiler_build(compiler* comp, char* input_filename, char* output_filename) {
+	bool result;
+
+	if ((comp->options.jobs > 1) && !comp->options.release_sources) {
+		if (comp->report && !compiler_report_enter(comp, REPORT_PREFETCH, SIZE_MAX)) return false;
+		result = compiler_prefetch(comp, input_filename);
+		if (comp->report) compiler_report_leave(comp);
+		if (!result) {
+			fputs("error : Source prefetching failure\n", stderr);
+			return false;
+		}
+	}
 	if (!compiler_compile_source(comp, input_filename)) return false;
-	if (!compiler_save_code(comp, output_filename)) {
+	if (comp->options.object) {
+		if (comp->report && !compiler_report_enter(comp, REPORT_SAVE, SIZE_MAX)) return false;
+		result = compiler_save_object(comp, output_filename);
+		if (comp->report) compiler_report_leave(comp);
+		if (!result) {
+			fputs("error : File saving failure\n", stderr);
+			return false;
+		}
+		return true;
+	}
+	if (comp->report && !compiler_report_enter(comp, REPORT_OPTIMIZE, SIZE_MAX)) return false;
+	result = compiler_optimize(comp);
+	if (comp->report) compiler_report_leave(comp);
+	if (!result) {
+		fputs("error : Optimization failure\n", stderr);
+		return false;
+	}
+	if (comp->report && !compiler_report_enter(comp, REPORT_SAVE, SIZE_MAX)) return false;
+	result = compiler_save_code(comp, output_filename);
+	if (comp->report) compiler_report_leave(comp);
+	if (!result) {
 		fputs("error : File saving failure\n", stderr);
 		return false;
 	}
@@ -72,7 +238,13 @@ bool compiler_compile(compiler* comp, char* input_filename, char* output_filenam
 }
 
 bool compiler_compile_source(compiler* comp, char* input_filename) {
-	int index = compiler_load_code(comp, input_filename);
+	size_t line_count = comp->line_count;
+	size_t column_count = comp->column_count;
+	char* mark_cursor = comp->mark_cursor;
+	size_t mark_column = comp->mark_column;
+	size_t preproc_count = comp->preproc_tokens_vector.size;
+	arena_mark mark = arena_save(&comp->arena);
+	int index = comp->report ? compiler_report_load_code(comp, input_filename) : compiler_load_code(comp, input_filename);
 	if (!index) {
 		fputs("error : Loading code failure\n", stderr);
 		return false;
@@ -81,10 +253,21 @@ bool compiler_compile_source(compiler* comp, char* input_filename) {
 		fputs("error : Textcode index stack memory allocation failure\n", stderr);
 		return false;
 	}
-	if (!compiler_tokenize(comp)) {
+	comp->line_count = 1;
+	comp->column_count = 0;
+	comp->mark_cursor = NULL;
+	if (!(comp->report ? compiler_report_tokenize(comp) : compiler_tokenize(comp))) {
+		if (comp->options.release_sources) compiler_release_code(comp, index - 1);
 		fputs("error : Tokenization failure\n", stderr);
 		return false;
 	}
+	if (comp->options.release_sources) compiler_release_code(comp, index - 1);
+	comp->line_count = line_count;
+	comp->column_count = column_count;
+	comp->mark_cursor = mark_cursor;
+	comp->mark_column = mark_column;
+	vector_resize(cctl_ptr(char), &comp->preproc_tokens_vector, preproc_count);
+	arena_reset(&comp->arena, mark);
 	if (!vector_pop_back(size_t, &comp->textcode_index_stack)) {
 		fputs("error : Textcode index stack memory allocation failure\n", stderr);
 		return false;
@@ -93,8 +276,9 @@ bool compiler_compile_source(compiler* comp, char* input_filename) {
 }
 
 size_t compiler_load_code(compiler* comp, char* filename) {
-	FILE* file;
-	size_t size;
+	source_file* source;
+	char* textcode;
+	size_t mapped = 0;
 
 	char filename_full[PATH_MAX];
 
@@ -104,65 +288,55 @@ size_t compiler_load_code(compiler* comp, char* filename) {
 	if (!(realpath(filename, filename_full))) goto FAILURE_FILEPATH;
 #endif
 
-	file = fopen(filename_full, "rb");
-	if (!file) {
-		fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename_full);
-		fputs("error : File reading failure\n", stderr);
-		return 0;
+	source = compiler_find_source(comp, filename_full);
+	if (source && source->textcode) {
+		textcode = source->textcode;
+		source->textcode = NULL;
+	}
+	else {
+		if (comp->options.release_sources) textcode = compiler_map_source(filename_full, &mapped);
+		else textcode = compiler_read_source(filename_full);
+		if (!textcode) {
+			fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename_full);
+			fputs("error : File reading failure\n", stderr);
+			return 0;
+		}
 	}
-
-	fseek(file, 0, SEEK_END);
-	size = ftell(file);
-	rewind(file);
 
 	int filename_size = strlen(filename_full) + 1;
 
-	char* textcode = (char*) malloc(size + 2);
 	char* filename_full_new = (char*) malloc(filename_size);
-	if (!(textcode && filename_full_new)) {
-		fclose(file);
+	if (!filename_full_new) {
+		compiler_unmap_source(textcode, mapped);
 		fputs("error : Textcode memory allocation failure\n", stderr);
 		return 0;
 	}
 
-	int read_result = fread(textcode, size, 1, file);
-	if (read_result != 1) {
-		free(textcode);
-		fclose(file);
-		fputs("error : Entire reading failure\n", stderr);
-		return 0;
-	}
-
-	textcode[size] = '\n';
-	textcode[size + 1] = '\0';
-
 #ifdef _WIN32
 	memcpy_s(filename_full_new, filename_size, filename_full, filename_size);
 #else
 	memcpy(filename_full_new, filename_full, filename_size);
 #endif
 
-	trie* filename_trie_result;
+	dict_entry* filename_entry;
 	bool already_imported = false;
-	filename_trie_result = trie_find(&comp->filename_trie, filename_full_new);
-	if (filename_trie_result) if (filename_trie_result->type == (uint8_t) true) already_imported = true;
-	if (!already_imported) filename_trie_result = trie_insert(&comp->filename_trie, filename_full_new, (uint8_t) true);
+	filename_entry = dict_find(&comp->filename_dict, filename_full_new);
+	if (filename_entry) if (filename_entry->type == (uint8_t) true) already_imported = true;
+	if (!already_imported) filename_entry = dict_insert(&comp->filename_dict, filename_full_new, (uint8_t) true);
 
 	if (!(
+			vector_push_back(size_t, &comp->textcode_size_vector, mapped) &&
 			vector_push_back(cctl_ptr(char), &comp->textcode_vector, textcode) &&
 			vector_push_back(cctl_ptr(char), &comp->filename_vector, filename_full_new) &&
-			filename_trie_result
+			filename_entry
 		)) {
-		free(textcode);
+		compiler_unmap_source(textcode, mapped);
 		free(filename_full_new);
-		fclose(file);
 		fputs("error : Textcode vector memory allocation failure\n", stderr);
 		return 0;
 	}
 
-	filename_trie_result->data.u = comp->textcode_vector.size - 1;
-
-	fclose(file);
+	filename_entry->data.u = comp->textcode_vector.size - 1;
 
 	return comp->textcode_vector.size;
 
@@ -172,24 +346,381 @@ FAILURE_FILEPATH:
 	return 0;
 }
 
+char* compiler_map_source(char* filename, size_t* mapped) {
+#ifdef _WIN32
+	*mapped = 0;
+	return compiler_read_source(filename);
+#else
+	struct stat status;
+	size_t page = sysconf(_SC_PAGESIZE);
+	size_t length;
+	char* textcode;
+	int file = open(filename, O_RDONLY);
+
+	if (file < 0) return NULL;
+	if (fstat(file, &status)) goto FAILURE;
+
+	length = (status.st_size + 2 + page - 1) / page * page;
+	textcode = (char*) mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (textcode == MAP_FAILED) goto FAILURE;
+	if (status.st_size) {
+		if (mmap(textcode, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file, 0) == MAP_FAILED) {
+			munmap(textcode, length);
+			goto FAILURE;
+		}
+		madvise(textcode, status.st_size, MADV_SEQUENTIAL);
+	}
+	close(file);
+
+	textcode[status.st_size] = '\n';
+	textcode[status.st_size + 1] = '\0';
+	*mapped = length;
+	return textcode;
+
+FAILURE:
+	close(file);
+	return NULL;
+#endif
+}
+
+void compiler_unmap_source(char* textcode, size_t mapped) {
+#ifdef _WIN32
+	free(textcode);
+#else
+	if (mapped) munmap(textcode, mapped);
+	else free(textcode);
+#endif
+}
+
+void compiler_release_code(compiler* comp, size_t index) {
+	char** textcode = vector_at(cctl_ptr(char), &comp->textcode_vector, index);
+
+	if (!*textcode) return;
+	compiler_unmap_source(*textcode, *vector_at(size_t, &comp->textcode_size_vector, index));
+	*textcode = NULL;
+}
+
+bool compiler_build_function_table(compiler* comp, vector(uint8_t)* table) {
+	uint8_t entry[BYTECODE_FUNCTION_ENTRY_SIZE];
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		if (!func->installed) continue;
+
+		bytecode_store_u64(entry, func->keyword);
+		bytecode_store_u64(entry + 8, func->begin + 1 + opcode_operand_size(*vector_at(uint8_t, &comp->bytecode, func->begin)));
+		bytecode_store_u64(entry + 16, func->end);
+		bytecode_store_u64(entry + 24, (func->ctrl == CTRL_MACRO) ? KWRD_MACRO : KWRD_FUNC);
+		for (int j = 0; j < BYTECODE_FUNCTION_ENTRY_SIZE; j++) {
+			if (!vector_push_back(uint8_t, table, entry[j])) return false;
+		}
+	}
+	return true;
+}
+
+bool compiler_build_metadata(compiler* comp, vector(uint8_t)* metadata) {
+	char line[PATH_MAX + 16];
+	int length = snprintf(line, sizeof(line), "producer=sabrc\n");
+
+	if (comp->filename_vector.size) {
+		length += snprintf(
+			line + length, sizeof(line) - length, "source=%s\n",
+			*vector_at(cctl_ptr(char), &comp->filename_vector, 0)
+		);
+	}
+	if (length >= (int) sizeof(line)) length = sizeof(line) - 1;
+
+	for (int i = 0; i < length; i++) {
+		if (!vector_push_back(uint8_t, metadata, line[i])) return false;
+	}
+	return true;
+}
+
+bool compiler_build_debug(compiler* comp, vector(uint8_t)* debug) {
+	size_t offset = 0;
+	size_t line = 0;
+
+	if (!compiler_push_uleb(debug, comp->filename_vector.size)) return false;
+	for (size_t i = 0; i < comp->filename_vector.size; i++) {
+		char* filename = *vector_at(cctl_ptr(char), &comp->filename_vector, i);
+		for (size_t j = 0; j <= strlen(filename); j++) {
+			if (!vector_push_back(uint8_t, debug, filename[j])) return false;
+		}
+	}
+
+	if (!compiler_push_uleb(debug, comp->dictionary_keyword_count)) return false;
+	if (!compiler_build_symbols(comp, debug)) return false;
+
+	if (!compiler_push_uleb(debug, comp->line_rows.size)) return false;
+	for (size_t i = 0; i < comp->line_rows.size; i++) {
+		line_row* row = vector_at(line_row, &comp->line_rows, i);
+		if (!compiler_push_uleb(debug, row->offset - offset)) return false;
+		if (!compiler_push_uleb(debug, row->file)) return false;
+		if (!compiler_push_uleb(debug, bytecode_zigzag((int64_t) row->line - (int64_t) line))) return false;
+		if (!compiler_push_uleb(debug, row->column)) return false;
+		offset = row->offset;
+		line = row->line;
+	}
+	return true;
+}
+
+bool compiler_push_uleb(vector(uint8_t)* out, uint64_t x) {
+	uint8_t bytes[10];
+	size_t size = bytecode_store_uleb(bytes, x);
+
+	for (size_t i = 0; i < size; i++) {
+		if (!vector_push_back(uint8_t, out, bytes[i])) return false;
+	}
+	return true;
+}
+
 bool compiler_save_code(compiler* comp, char* filename) {
 	FILE* file;
+	bytecode_image image;
+	vector(uint8_t) table;
+	vector(uint8_t) metadata;
+	vector(uint8_t) debug;
+	bool result = false;
+
+	vector_init(uint8_t, &table);
+	vector_init(uint8_t, &metadata);
+	vector_init(uint8_t, &debug);
+	bytecode_init(&image);
+
+	if (!compiler_build_function_table(comp, &table)) goto FAILURE_ALLOC;
+	if (!compiler_build_metadata(comp, &metadata)) goto FAILURE_ALLOC;
+	if (comp->options.debug && !compiler_build_debug(comp, &debug)) goto FAILURE_ALLOC;
+
+	image.keyword_count = comp->dictionary_keyword_count;
+	image.entry = 0;
+	bytecode_add_section(&image, SECTION_CODE, comp->bytecode.p_data, comp->bytecode.size);
+	bytecode_add_section(&image, SECTION_FUNCTIONS, table.p_data, table.size);
+	bytecode_add_section(&image, SECTION_CONSTANTS, comp->constants.p_data, comp->constants.size);
+	bytecode_add_section(&image, SECTION_METADATA, metadata.p_data, metadata.size);
+	if (comp->options.debug) bytecode_add_section(&image, SECTION_DEBUG, debug.p_data, debug.size);
+	if (comp->options.compress && !bytecode_compress(&image)) goto FAILURE_ALLOC;
+
 	file = fopen(filename, "wb");
+	if (!file) goto FAILURE_WRITE;
+	result = bytecode_save(&image, file);
+	if (fclose(file)) result = false;
+	if (!result) goto FAILURE_WRITE;
+
+	bytecode_free(&image);
+	vector_free(uint8_t, &table);
+	vector_free(uint8_t, &metadata);
+	vector_free(uint8_t, &debug);
+	return true;
+
+FAILURE_ALLOC:
+	fputs("error : Section memory allocation failure\n", stderr);
+	goto FAILURE;
+FAILURE_WRITE:
+	fputs("error : File writing failure\n", stderr);
+FAILURE:
+	bytecode_free(&image);
+	vector_free(uint8_t, &table);
+	vector_free(uint8_t, &metadata);
+	vector_free(uint8_t, &debug);
+	return false;
+}
+
+bool compiler_build_object_functions(compiler* comp, vector(uint8_t)* table) {
+	uint8_t entry[BYTECODE_FUNCTION_ENTRY_SIZE];
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		uint64_t type = (func->ctrl == CTRL_MACRO) ? KWRD_MACRO : KWRD_FUNC;
+		if (!func->end) continue;
+		if (func->toplevel) type |= BYTECODE_FUNCTION_TOPLEVEL;
+
+		bytecode_store_u64(entry, func->keyword);
+		bytecode_store_u64(entry + 8, func->begin);
+		bytecode_store_u64(entry + 16, func->end);
+		bytecode_store_u64(entry + 24, type);
+		for (int j = 0; j < BYTECODE_FUNCTION_ENTRY_SIZE; j++) {
+			if (!vector_push_back(uint8_t, table, entry[j])) return false;
+		}
+	}
+	return true;
+}
+
+bool compiler_collect_symbols(dict* d, vector(uint8_t)* names, size_t* offsets) {
+	for (size_t i = 0; i < d->capacity; i++) {
+		dict_entry* word = d->entries[i];
+		if (!word || (word->type != WTT_KWRD)) continue;
+		offsets[word->data.u] = names->size;
+		for (char* key = word->key; *key; key++) {
+			if (!vector_push_back(uint8_t, names, *key)) return false;
+		}
+		if (!vector_push_back(uint8_t, names, 0)) return false;
+	}
+	return true;
+}
+
+bool compiler_build_symbols(compiler* comp, vector(uint8_t)* symbols) {
+	vector(uint8_t) names;
+	size_t* offsets = (size_t*) malloc((comp->dictionary_keyword_count + 1) * sizeof(size_t));
+
+	vector_init(uint8_t, &names);
+	if (!offsets) goto FAILURE;
+	for (size_t i = 0; i <= comp->dictionary_keyword_count; i++) {
+		offsets[i] = SIZE_MAX;
+	}
+	if (!compiler_collect_symbols(&comp->dictionary, &names, offsets)) goto FAILURE;
 
-	size_t result = fwrite(comp->bytecode.p_data, 1, comp->bytecode.size, file);
+	for (size_t i = 1; i <= comp->dictionary_keyword_count; i++) {
+		for (size_t j = offsets[i]; (j != SIZE_MAX) && *vector_at(uint8_t, &names, j); j++) {
+			if (!vector_push_back(uint8_t, symbols, *vector_at(uint8_t, &names, j))) goto FAILURE;
+		}
+		if (!vector_push_back(uint8_t, symbols, 0)) goto FAILURE;
+	}
+
+	vector_free(uint8_t, &names);
+	free(offsets);
+	return true;
 
+FAILURE:
+	vector_free(uint8_t, &names);
+	free(offsets);
+	return false;
+}
+
+bool compiler_build_relocations(compiler* comp, vector(uint8_t)* relocations) {
+	uint8_t cell[8];
+
+	for (size_t i = 0; i < comp->keyword_sites.size; i++) {
+		bytecode_store_u64(cell, *vector_at(size_t, &comp->keyword_sites, i));
+		for (int j = 0; j < 8; j++) {
+			if (!vector_push_back(uint8_t, relocations, cell[j])) return false;
+		}
+	}
+	return true;
+}
+
+bool compiler_save_object(compiler* comp, char* filename) {
+	FILE* file;
+	bytecode_image image;
+	vector(uint8_t) table;
+	vector(uint8_t) symbols;
+	vector(uint8_t) relocations;
+	vector(uint8_t) metadata;
+	bool result = false;
+
+	vector_init(uint8_t, &table);
+	vector_init(uint8_t, &symbols);
+	vector_init(uint8_t, &relocations);
+	vector_init(uint8_t, &metadata);
+
+	if (!compiler_build_object_functions(comp, &table)) goto FAILURE_ALLOC;
+	if (!compiler_build_symbols(comp, &symbols)) goto FAILURE_ALLOC;
+	if (!compiler_build_relocations(comp, &relocations)) goto FAILURE_ALLOC;
+	if (!compiler_build_metadata(comp, &metadata)) goto FAILURE_ALLOC;
+
+	bytecode_init(&image);
+	image.flags = BYTECODE_FLAG_OBJECT;
+	image.keyword_count = comp->dictionary_keyword_count;
+	image.entry = 0;
+	bytecode_add_section(&image, SECTION_CODE, comp->bytecode.p_data, comp->bytecode.size);
+	bytecode_add_section(&image, SECTION_FUNCTIONS, table.p_data, table.size);
+	bytecode_add_section(&image, SECTION_CONSTANTS, comp->constants.p_data, comp->constants.size);
+	bytecode_add_section(&image, SECTION_SYMBOLS, symbols.p_data, symbols.size);
+	bytecode_add_section(&image, SECTION_RELOCATIONS, relocations.p_data, relocations.size);
+	bytecode_add_section(&image, SECTION_METADATA, metadata.p_data, metadata.size);
+
+	file = fopen(filename, "wb");
+	if (!file) goto FAILURE_WRITE;
+	result = bytecode_save(&image, file);
+	if (fclose(file)) result = false;
+	if (!result) goto FAILURE_WRITE;
+
+	vector_free(uint8_t, &table);
+	vector_free(uint8_t, &symbols);
+	vector_free(uint8_t, &relocations);
+	vector_free(uint8_t, &metadata);
+	return true;
+
+FAILURE_ALLOC:
+	fputs("error : Section memory allocation failure\n", stderr);
+	goto FAILURE;
+FAILURE_WRITE:
+	fputs("error : File writing failure\n", stderr);
+FAILURE:
+	vector_free(uint8_t, &table);
+	vector_free(uint8_t, &symbols);
+	vector_free(uint8_t, &relocations);
+	vector_free(uint8_t, &metadata);
+	return false;
+}
+
+bool compiler_object_file(char* filename) {
+	uint8_t header[BYTECODE_HEADER_SIZE];
+	FILE* file = fopen(filename, "rb");
+	bool result = false;
+
+	if (!file) return false;
+	if (fread(header, BYTECODE_HEADER_SIZE, 1, file) == 1) {
+		result = !memcmp(header, BYTECODE_MAGIC, 4) && (bytecode_load_u32(header + 12) & BYTECODE_FLAG_OBJECT);
+	}
 	fclose(file);
+	return result;
+}
 
-	if (result != comp->bytecode.size) {
-		fputs("error : File writing failure\n", stderr);
-		return false;
+bool compiler_import_object(compiler* comp, char* filename) {
+	bytecode_image image;
+	bytecode_section* section;
+	uint8_t* data = NULL;
+	size_t size;
+	dict_entry* word;
+
+	if (!comp->options.object) goto FAILURE_MODE;
+	if (!bytecode_read_file(filename, &data, &size)) goto FAILURE_READ;
+	if (!bytecode_parse(&image, data, size)) goto FAILURE_OBJECT;
+	section = bytecode_find_section(&image, SECTION_SYMBOLS);
+	if (!section) goto FAILURE_OBJECT;
+	if (section->size && section->data[section->size - 1]) goto FAILURE_OBJECT;
+
+	for (size_t i = 0; i < section->size; i += strlen((const char*) section->data + i) + 1) {
+		const char* name = (const char*) section->data + i;
+		word = dict_find(&comp->dictionary, name);
+		if (word) {
+			if (word->type != WTT_KWRD) goto FAILURE_OBJECT;
+			continue;
+		}
+		word = dict_insert(&comp->dictionary, name, WTT_KWRD);
+		if (!word) goto FAILURE_DICT;
+		word->data.u = ++comp->dictionary_keyword_count;
 	}
 
+	word = dict_insert(&comp->filename_dict, filename, (uint8_t) true);
+	if (!word) goto FAILURE_DICT;
+	if (!compiler_add_dependency(comp, filename)) goto FAILURE_DICT;
+	free(data);
 	return true;
+
+FAILURE_MODE:
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename);
+	fputs("error : Object files can only be imported when compiling with -c\n", stderr);
+	return false;
+FAILURE_READ:
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename);
+	fputs("error : File reading failure\n", stderr);
+	return false;
+FAILURE_OBJECT:
+	free(data);
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename);
+	fputs("error : Invalid object file\n", stderr);
+	return false;
+FAILURE_DICT:
+	free(data);
+	fputs("error : Dictionary memory allocation failure\n", stderr);
+	return false;
 }
 
 bool compiler_tokenize(compiler* comp) {
 	size_t index;
+	vector(token) tokens;
+	source_file* source;
 
 	if (comp->textcode_index_stack.size == 0) {
 		fputs("error : Textcode index error\n", stderr);
@@ -198,24 +729,60 @@ bool compiler_tokenize(compiler* comp) {
 
 	index = *vector_back(size_t, &comp->textcode_index_stack);
 
-	char* iterator = *vector_at(cctl_ptr(char), &comp->textcode_vector, index);
+	vector_init(token, &tokens);
+	source = compiler_find_source(comp, *vector_at(cctl_ptr(char), &comp->filename_vector, index));
+	if (source && source->ready && !source->textcode) {
+		tokens = source->tokens;
+		vector_init(token, &source->tokens);
+		source->ready = false;
+	}
+	else if (!compiler_scan_tokens(*vector_at(cctl_ptr(char), &comp->textcode_vector, index), &tokens)) {
+		vector_free(token, &tokens);
+		fputs("error : Token vector memory allocation failure\n", stderr);
+		return false;
+	}
+	if (comp->report) compiler_report_scanned(comp, tokens.capacity * sizeof(token));
+
+	for (size_t i = 0; i < tokens.size; i++) {
+		token* tok = vector_at(token, &tokens, i);
+		comp->line_count = tok->line;
+		comp->column_count = tok->column;
+		if (!(comp->report ? compiler_report_parse(comp, tok->begin, tok->end) : compiler_parse(comp, tok->begin, tok->end))) {
+			vector_free(token, &tokens);
+			fprintf(stderr, "from file " console_yellow console_bold "%s" console_reset "\n", *vector_at(cctl_ptr(char), &comp->filename_vector, index));
+			fputs("error : Parse failure\n", stderr);
+			return false;
+		}
+	}
+	vector_free(token, &tokens);
+	compiler_resolve_relocations(comp);
+
+	if (comp->control_frames.size > 0) {
+		fputs("error : Control level does not match\n", stderr);
+		return false;
+	}
+
+	return true;
+}
+
+bool compiler_scan_tokens(char* iterator, vector(token)* tokens) {
+	char* limit = iterator + strlen(iterator);
+	size_t line = 1;
+	size_t column = 0;
 	char* begin = NULL;
-	char* end = NULL;
+	token tok;
 
 	bool string_escape = false;
 	bool space = true;
 	string_parse_mode string_parse = STR_PARSE_NONE;
 	comment_parse_mode comment = CMNT_PARSE_NONE;
-	bool result;
-
-	bool u8check = false;
 
 	while (*iterator) {
 		switch (*iterator) {
 			case '\n': 
-				comp->line_count++;
+				line++;
 			case '\r':
-				comp->column_count = 0;
+				column = 0;
 				if (comment == CMNT_PARSE_LINE) {
 					space = true;
 					comment = CMNT_PARSE_NONE;
@@ -228,13 +795,11 @@ bool compiler_tokenize(compiler* comp) {
 							if (string_escape) string_escape = false;
 						}
 						else {
-							end = iterator;
-							result = compiler_parse(comp, begin, end);
-							if (!result) {
-								fprintf(stderr, "from file " console_yellow console_bold "%s" console_reset "\n", *vector_at(cctl_ptr(char), &comp->filename_vector, index));
-								fputs("error : Parse failure\n", stderr);
-								return false;
-							}
+							tok.begin = begin;
+							tok.end = iterator;
+							tok.line = line;
+							tok.column = column;
+							if (!vector_push_back(token, tokens, tok)) return false;
 							space = true;
 						}
 					}
@@ -274,13 +839,16 @@ bool compiler_tokenize(compiler* comp) {
 						string_parse = STR_PARSE_DOUBLE;
 						string_escape = false;
 					}
+					else if ((begin == iterator - 1) && (*begin == '@')) {
+						string_parse = STR_PARSE_DOUBLE;
+						string_escape = false;
+					}
 				}
 			} break;
 			case '\\': {
 				if (!comment) {
 					if (string_parse) {
-						if (string_escape) string_parse = false;
-						else string_parse = true;
+						string_escape = !string_escape;
 					}
 					else if (space) {
 						space = false;
@@ -326,15 +894,12 @@ bool compiler_tokenize(compiler* comp) {
 		}
 		iterator++;
 		
-		if (((signed char) *iterator) >= -64) {
-			comp->column_count++;
+		if (scanner_lead(*iterator)) {
+			column++;
+		}
+		if (comment || (!space && !string_escape)) {
+			iterator = scanner_skip(iterator, limit, &column);
 		}
-		
-	}
-
-	if (comp->control_data_stack.size > 0) {
-		fputs("error : Control level does not match\n", stderr);
-		return false;
 	}
 
 	return true;
@@ -343,12 +908,14 @@ bool compiler_tokenize(compiler* comp) {
 bool compiler_parse(compiler* comp, char* begin, char* end) {
 	bool result;
 	char temp = *end;
+
+	if (comp->options.debug && !compiler_mark_source(comp, begin, end)) return false;
 	*end = 0;
 
-	trie* trie_result = trie_find(&comp->dictionary, begin);
+	dict_entry* dict_result = dict_find(&comp->dictionary, begin);
 
-	if (trie_result) {
-		result = compiler_parse_word_token(comp, trie_result);
+	if (dict_result) {
+		result = compiler_parse_word_token(comp, dict_result);
 	}
 	else {
 		switch (*begin) {
@@ -383,6 +950,17 @@ bool compiler_parse(compiler* comp, char* begin, char* end) {
 				result = compiler_parse_char(comp, begin + 1, true);
 				*(end - 1) = temp_parse_char;
 			} break;
+			case '@': {
+				if ((begin[1] != '\"') || (end - begin < 3) || (*(end - 1) != '\"')) {
+					result = false;
+					fputs("error : Unknown keyword\n", stderr);
+					break;
+				}
+				char temp_parse_char = *(end - 1);
+				*(end - 1) = 0;
+				result = compiler_parse_data(comp, begin + 2);
+				*(end - 1) = temp_parse_char;
+			} break;
 			default: {
 				result = false;
 				fputs("error : Unknown keyword\n", stderr);
@@ -398,20 +976,48 @@ bool compiler_parse(compiler* comp, char* begin, char* end) {
 	return result;
 }
 
-bool compiler_parse_word_token(compiler* comp, trie* trie_result) {
+bool compiler_mark_source(compiler* comp, char* begin, char* end) {
+	char* text = *vector_at(cctl_ptr(char), &comp->textcode_vector, *vector_back(size_t, &comp->textcode_index_stack));
+	line_row row;
+
+	row.offset = comp->bytecode.size;
+	row.file = *vector_back(size_t, &comp->textcode_index_stack);
+	row.line = comp->line_count - (*end == '\n');
+	if (!comp->mark_cursor) {
+		comp->mark_cursor = text;
+		comp->mark_column = 1;
+	}
+	for (; comp->mark_cursor < begin; comp->mark_cursor++) {
+		if (*comp->mark_cursor == '\n') comp->mark_column = 1;
+		else if (((signed char) *comp->mark_cursor) >= -64) comp->mark_column++;
+	}
+	row.column = comp->mark_column;
+
+	if (comp->line_rows.size && (vector_back(line_row, &comp->line_rows)->offset == row.offset)) {
+		*vector_back(line_row, &comp->line_rows) = row;
+		return true;
+	}
+	if (!vector_push_back(line_row, &comp->line_rows, row)) {
+		fputs("error : Line table memory allocation failure\n", stderr);
+		return false;
+	}
+	return true;
+}
+
+bool compiler_parse_word_token(compiler* comp, dict_entry* dict_result) {
 	bool result = false;
 
-	switch (trie_result->type) {
+	switch (dict_result->type) {
 		case WTT_CTRL: {
-			result = compiler_parse_control_words(comp, trie_result);
+			result = comp->report ? compiler_report_control_words(comp, dict_result) : compiler_parse_control_words(comp, dict_result);
 		} break;
 		case WTT_KWRD: {
-			value v = trie_result->data;
+			value v = dict_result->data;
 			if (!compiler_push_bytecode_with_value(comp, OP_CALL, v)) return false;
 			result = true;
 		} break;
 		case WTT_OP: {
-			value v = trie_result->data;
+			value v = dict_result->data;
 			if (!compiler_push_bytecode(comp, (opcode) (v.u))) return false;
 			result = true;
 		} break;
@@ -420,103 +1026,84 @@ bool compiler_parse_word_token(compiler* comp, trie* trie_result) {
 	return result;
 }
 
-bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
+bool compiler_parse_control_words(compiler* comp, dict_entry* dict_result) {
 	control_data current_ctrl;
-	current_ctrl.ctrl = trie_result->data.u;
+	current_ctrl.ctrl = dict_result->data.u;
 	current_ctrl.pos = comp->bytecode.size;
 
-	vector(control_data)* temp_ctrl_vec;
+	size_t frame;
+	size_t count;
 
 	switch (current_ctrl.ctrl) {
 		case CTRL_IF: {
-			temp_ctrl_vec = (vector(control_data)*) malloc(sizeof(vector(control_data)));
-			if (!temp_ctrl_vec) goto FAILURE_CTRL_VECTOR;
-			vector_init(control_data, temp_ctrl_vec);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
-			if (!vector_push_back(cctl_ptr(vector(control_data)), &comp->control_data_stack, temp_ctrl_vec)) goto FAILURE_CTRL_STACK;
+			if (!compiler_open_control(comp, current_ctrl)) goto FAILURE_CTRL_STACK;
 			if (!compiler_push_bytecode_with_null(comp, OP_IF)) return false;
 		} break;
 		case CTRL_ELSE: {
-			if (!comp->control_data_stack.size) goto FAILURE_CTRL;
-			temp_ctrl_vec = *vector_back(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
+			if (!comp->control_frames.size) goto FAILURE_CTRL;
+			if (!vector_push_back(control_data, &comp->control_entries, current_ctrl)) goto FAILURE_CTRL_VECTOR;
 			if (!compiler_push_bytecode_with_null(comp, OP_JUMP)) return false;
 		} break;
 		case CTRL_LOOP: {
-			temp_ctrl_vec = (vector(control_data)*) malloc(sizeof(vector(control_data)));
-			if (!temp_ctrl_vec) goto FAILURE_CTRL_VECTOR;
-			vector_init(control_data, temp_ctrl_vec);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
-			if (!vector_push_back(cctl_ptr(vector(control_data)), &comp->control_data_stack, temp_ctrl_vec)) goto FAILURE_CTRL_STACK;
+			if (!compiler_open_control(comp, current_ctrl)) goto FAILURE_CTRL_STACK;
 		} break;
 		case CTRL_WHILE: {
-			if (!comp->control_data_stack.size) goto FAILURE_CTRL;
-			temp_ctrl_vec = *vector_back(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
+			if (!comp->control_frames.size) goto FAILURE_CTRL;
+			if (!vector_push_back(control_data, &comp->control_entries, current_ctrl)) goto FAILURE_CTRL_VECTOR;
 			if (!compiler_push_bytecode_with_null(comp, OP_IF)) return false;
 		} break;
 		case CTRL_CONTINUE:
 		case CTRL_BREAK: {
-			if (!comp->control_data_stack.size) goto FAILURE_CTRL;
-			temp_ctrl_vec = *vector_back(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
+			if (!comp->control_frames.size) goto FAILURE_CTRL;
+			if (!vector_push_back(control_data, &comp->control_entries, current_ctrl)) goto FAILURE_CTRL_VECTOR;
 			if (!compiler_push_bytecode_with_null(comp, OP_JUMP)) return false;
 		} break;
 		case CTRL_SWITCH: {
-			temp_ctrl_vec = (vector(control_data)*) malloc(sizeof(vector(control_data)));
-			if (!temp_ctrl_vec) goto FAILURE_CTRL_VECTOR;
-			vector_init(control_data, temp_ctrl_vec);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
-			if (!vector_push_back(cctl_ptr(vector(control_data)), &comp->control_data_stack, temp_ctrl_vec)) goto FAILURE_CTRL_STACK;
+			if (!compiler_open_control(comp, current_ctrl)) goto FAILURE_CTRL_STACK;
 			if (!compiler_push_bytecode(comp, OP_SWITCH)) return false;
 		} break;
 		case CTRL_CASE: {
-			if (!comp->control_data_stack.size) goto FAILURE_CTRL;
-			temp_ctrl_vec = *vector_back(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
+			if (!comp->control_frames.size) goto FAILURE_CTRL;
+			if (!vector_push_back(control_data, &comp->control_entries, current_ctrl)) goto FAILURE_CTRL_VECTOR;
 			if (!compiler_push_bytecode(comp, OP_CASE)) return false;
 			if (!compiler_push_bytecode(comp, OP_EQU)) return false;
 			if (!compiler_push_bytecode_with_null(comp, OP_IF)) return false;
 		} break;
 		case CTRL_PASS: {
-			if (!comp->control_data_stack.size) goto FAILURE_CTRL;
-			temp_ctrl_vec = *vector_back(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
+			if (!comp->control_frames.size) goto FAILURE_CTRL;
+			if (!vector_push_back(control_data, &comp->control_entries, current_ctrl)) goto FAILURE_CTRL_VECTOR;
 			if (!compiler_push_bytecode_with_null(comp, OP_JUMP)) return false;
 		} break;
 		case CTRL_FUNC: {
-			temp_ctrl_vec = (vector(control_data)*) malloc(sizeof(vector(control_data)));
-			if (!temp_ctrl_vec) goto FAILURE_CTRL_VECTOR;
-			vector_init(control_data, temp_ctrl_vec);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
-			if (!vector_push_back(cctl_ptr(vector(control_data)), &comp->control_data_stack, temp_ctrl_vec)) goto FAILURE_CTRL_STACK;
+			if (!compiler_open_control(comp, current_ctrl)) goto FAILURE_CTRL_STACK;
+			if (!compiler_push_function(comp, &current_ctrl)) return false;
 			if (!compiler_push_bytecode_with_null(comp, OP_FUNC)) return false;
 		} break;
 		case CTRL_MACRO: {
-			temp_ctrl_vec = (vector(control_data)*) malloc(sizeof(vector(control_data)));
-			if (!temp_ctrl_vec) goto FAILURE_CTRL_VECTOR;
-			vector_init(control_data, temp_ctrl_vec);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
-			if (!vector_push_back(cctl_ptr(vector(control_data)), &comp->control_data_stack, temp_ctrl_vec)) goto FAILURE_CTRL_STACK;
+			if (!compiler_open_control(comp, current_ctrl)) goto FAILURE_CTRL_STACK;
+			if (!compiler_push_function(comp, &current_ctrl)) return false;
 			if (!compiler_push_bytecode_with_null(comp, OP_MACRO)) return false;
 		} break;
+		case CTRL_IMMEDIATE: {
+			if (!compiler_open_control(comp, current_ctrl)) goto FAILURE_CTRL_STACK;
+		} break;
 		case CTRL_RETURN: {
-			if (!comp->control_data_stack.size) goto FAILURE_CTRL;
-			temp_ctrl_vec = *vector_back(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-			if (!vector_push_back(control_data, temp_ctrl_vec, current_ctrl)) goto FAILURE_CTRL_VECTOR;
+			if (!comp->control_frames.size) goto FAILURE_CTRL;
+			if (!vector_push_back(control_data, &comp->control_entries, current_ctrl)) goto FAILURE_CTRL_VECTOR;
 			if (!compiler_push_bytecode(comp, OP_RETURN)) return false;
 		} break;
 		case CTRL_END: {
 			value pos;
-			if (comp->control_data_stack.size == 0) goto FAILURE_CTRL_STACK;
-			temp_ctrl_vec = *vector_back(cctl_ptr(vector(control_data)), &comp->control_data_stack);
-			control_data* first_ctrl = vector_front(control_data, temp_ctrl_vec);
+			if (comp->control_frames.size == 0) goto FAILURE_CTRL_STACK;
+			frame = *vector_back(size_t, &comp->control_frames);
+			count = comp->control_entries.size - frame;
+			control_data* first_ctrl = vector_at(control_data, &comp->control_entries, frame);
 			control_data* while_else_ctrl = NULL;
 			switch (first_ctrl->ctrl) {
 				case CTRL_IF: {
 					for (
-						control_data* iter = vector_at(control_data, temp_ctrl_vec, 1);
-						iter <= vector_back(control_data, temp_ctrl_vec);
+						control_data* iter = first_ctrl + 1;
+						iter < first_ctrl + count;
 						iter++
 					) {
 						switch (iter->ctrl) {
@@ -526,10 +1113,8 @@ bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
 							case CTRL_BREAK:
 							case CTRL_CONTINUE:
 							case CTRL_RETURN: {
-								vector(control_data)* next_ctrl_vec;
-								if (comp->control_data_stack.size < 2) goto FAILURE_CTRL_STACK;
-								next_ctrl_vec = *vector_at(cctl_ptr(vector(control_data)), &comp->control_data_stack, comp->control_data_stack.size - 2);
-								if (!vector_push_back(control_data, next_ctrl_vec, *iter)) goto FAILURE_CTRL_VECTOR;
+								if (comp->control_frames.size < 2) goto FAILURE_CTRL_STACK;
+								if (!vector_push_back(control_data, &comp->control_pending, *iter)) goto FAILURE_CTRL_VECTOR;
 							} break;
 							default: {
 								goto FAILURE_CTRL;
@@ -538,52 +1123,38 @@ bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
 					}
 					if (while_else_ctrl) {
 						pos.u = while_else_ctrl->pos + 9;
-						for (int i = 0; i < 8; i++) {
-							*vector_at(uint8_t, &comp->bytecode, first_ctrl->pos + 1 + i) = pos.bytes[i];
-						}
+						if (!compiler_relocate(comp, first_ctrl->pos + 1, pos.u)) return false;
 						pos.u = current_ctrl.pos;
-						for (int i = 0; i < 8; i++) {
-							*vector_at(uint8_t, &comp->bytecode, while_else_ctrl->pos + 1 + i) = pos.bytes[i];
-						}
+						if (!compiler_relocate(comp, while_else_ctrl->pos + 1, pos.u)) return false;
 					}
 					else {
 						pos.u = current_ctrl.pos;
-						for (int i = 0; i < 8; i++) {
-							*vector_at(uint8_t, &comp->bytecode, first_ctrl->pos + 1 + i) = pos.bytes[i];
-						}
+						if (!compiler_relocate(comp, first_ctrl->pos + 1, pos.u)) return false;
 					}
 				} break;
 				case CTRL_LOOP: {
 					for (
-						control_data* iter = vector_at(control_data, temp_ctrl_vec, 1);
-						iter <= vector_back(control_data, temp_ctrl_vec);
+						control_data* iter = first_ctrl + 1;
+						iter < first_ctrl + count;
 						iter++
 					) {
 						switch (iter->ctrl) {
 							case CTRL_WHILE: {
 								while_else_ctrl = iter;
 								pos.u = current_ctrl.pos + 9;
-								for (int i = 0; i < 8; i++) {
-									*vector_at(uint8_t, &comp->bytecode, while_else_ctrl->pos + 1 + i) = pos.bytes[i];
-								}
+								if (!compiler_relocate(comp, while_else_ctrl->pos + 1, pos.u)) return false;
 							} break;
 							case CTRL_BREAK: {
 								pos.u = current_ctrl.pos + 9;
-								for (int i = 0; i < 8; i++) {
-									*vector_at(uint8_t, &comp->bytecode, iter->pos + 1 + i) = pos.bytes[i];
-								}
+								if (!compiler_relocate(comp, iter->pos + 1, pos.u)) return false;
 							} break;
 							case CTRL_CONTINUE: {
 								pos.u = first_ctrl->pos;
-								for (int i = 0; i < 8; i++) {
-									*vector_at(uint8_t, &comp->bytecode, iter->pos + 1 + i) = pos.bytes[i];
-								}
+								if (!compiler_relocate(comp, iter->pos + 1, pos.u)) return false;
 							} break;
 							case CTRL_RETURN: {
-								vector(control_data)* next_ctrl_vec;
-								if (comp->control_data_stack.size < 2) goto FAILURE_CTRL_STACK;
-								next_ctrl_vec = *vector_at(cctl_ptr(vector(control_data)), &comp->control_data_stack, comp->control_data_stack.size - 2);
-								if (!vector_push_back(control_data, next_ctrl_vec, *iter)) goto FAILURE_CTRL_VECTOR;
+								if (comp->control_frames.size < 2) goto FAILURE_CTRL_STACK;
+								if (!vector_push_back(control_data, &comp->control_pending, *iter)) goto FAILURE_CTRL_VECTOR;
 							} break;
 							default: {
 								goto FAILURE_CTRL;
@@ -594,18 +1165,13 @@ bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
 					if (!compiler_push_bytecode_with_value(comp, OP_JUMP, pos)) return false;
 				} break;
 				case CTRL_SWITCH: {
-					#define __free_switch_vecs__ \
-						vector_free(control_data, &case_vec); \
-						vector_free(control_data, &pass_vec); \
-						vector_free(control_data, &chain_vec);
-					
-					vector(control_data) case_vec;
-					vector(control_data) pass_vec;
-					vector(control_data) chain_vec;
-
-					vector_init(control_data, &case_vec);
-					vector_init(control_data, &pass_vec);
-					vector_init(control_data, &chain_vec);
+					vector(control_data)* case_vec = &comp->switch_cases;
+					vector(control_data)* pass_vec = &comp->switch_passes;
+					vector(control_data)* chain_vec = &comp->switch_chains;
+
+					vector_clear(control_data, case_vec);
+					vector_clear(control_data, pass_vec);
+					vector_clear(control_data, chain_vec);
 
 					pos.u = current_ctrl.pos;
 
@@ -616,51 +1182,32 @@ bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
 					bool pass_existance = false;
 
 					for (
-						control_data* iter = vector_at(control_data, temp_ctrl_vec, 1);
-						iter <= vector_back(control_data, temp_ctrl_vec);
+						control_data* iter = first_ctrl + 1;
+						iter < first_ctrl + count;
 						iter++
 					) {
 						switch (iter->ctrl) {
 							case CTRL_CASE: {
 								if (chain) {
-									if (!vector_push_back(control_data, &pass_vec, *iter)) {
-										__free_switch_vecs__;
-										goto FAILURE_CTRL_VECTOR;
-									}
-								}
-								if (!vector_push_back(control_data, &case_vec, *iter)) {
-									__free_switch_vecs__;
-									goto FAILURE_CTRL_VECTOR;
+									if (!vector_push_back(control_data, pass_vec, *iter)) goto FAILURE_CTRL_VECTOR;
 								}
+								if (!vector_push_back(control_data, case_vec, *iter)) goto FAILURE_CTRL_VECTOR;
 								chain = true;
 								case_existance = true;
 							} break;
 							case CTRL_PASS: {
 								chain = false;
-								for (int i = 0; i < 8; i++)
-									*vector_at(uint8_t, &comp->bytecode, iter->pos + 1 + i) = pos.bytes[i];
-								if (!vector_push_back(control_data, &pass_vec, *iter)) {
-									__free_switch_vecs__;
-									goto FAILURE_CTRL_VECTOR;
-								}
+								if (!compiler_relocate(comp, iter->pos + 1, pos.u)) return false;
+								if (!vector_push_back(control_data, pass_vec, *iter)) goto FAILURE_CTRL_VECTOR;
 								pass_existance = true;
 							} break;
 							case CTRL_BREAK:
 							case CTRL_CONTINUE:
 							case CTRL_RETURN: {
-								vector(control_data)* next_ctrl_vec;
-								if (comp->control_data_stack.size < 2) {
-									__free_switch_vecs__;
-									goto FAILURE_CTRL_STACK;
-								}
-								next_ctrl_vec = *vector_at(cctl_ptr(vector(control_data)), &comp->control_data_stack, comp->control_data_stack.size - 2);
-								if (!vector_push_back(control_data, next_ctrl_vec, *iter)) {
-									__free_switch_vecs__;
-									goto FAILURE_CTRL_VECTOR;
-								}
+								if (comp->control_frames.size < 2) goto FAILURE_CTRL_STACK;
+								if (!vector_push_back(control_data, &comp->control_pending, *iter)) goto FAILURE_CTRL_VECTOR;
 							} break;
 							default: {
-								__free_switch_vecs__;
 								goto FAILURE_CTRL;
 							}
 						}
@@ -668,57 +1215,43 @@ bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
 
 					if (!(
 						pass_existance && case_existance &&
-						(pass_existance ? (vector_at(control_data, temp_ctrl_vec, 1)->ctrl == CTRL_CASE) : 0)
-					)) {
-						__free_switch_vecs__;
-						goto FAILURE_CTRL;
-					}
+						(pass_existance ? (first_ctrl[1].ctrl == CTRL_CASE) : 0)
+					)) goto FAILURE_CTRL;
 
-					control_data* iter_case = vector_front(control_data, &case_vec);
-					control_data* iter_pass = vector_front(control_data, &pass_vec);
+					control_data* iter_case = vector_front(control_data, case_vec);
+					control_data* iter_pass = vector_front(control_data, pass_vec);
 
-					for (; iter_case <= vector_back(control_data, &case_vec); iter_case++) {
+					for (; iter_case <= vector_back(control_data, case_vec); iter_case++) {
 						if (iter_pass->ctrl == CTRL_PASS) {
-							if (chain_vec.size) {
+							if (chain_vec->size) {
 								for (
-									control_data* iter_chain = vector_front(control_data, &chain_vec);
-									iter_chain <= vector_back(control_data, &chain_vec);
+									control_data* iter_chain = vector_front(control_data, chain_vec);
+									iter_chain <= vector_back(control_data, chain_vec);
 									iter_chain++
 								) {
 									pos.u = iter_case->pos + 11;
-									for (int i = 0; i < 8; i++) {
-										*vector_at(uint8_t, &comp->bytecode, iter_chain->pos + 3 + i) = pos.bytes[i];
-									}
+									if (!compiler_relocate(comp, iter_chain->pos + 3, pos.u)) return false;
 									*vector_at(uint8_t, &comp->bytecode, iter_chain->pos + 1) = OP_NEQ;
 								}
-								vector_clear(control_data, &chain_vec);
+								vector_clear(control_data, chain_vec);
 							}
 
 							pos.u = iter_pass->pos + 9;
-							for (int i = 0; i < 8; i++) {
-								*vector_at(uint8_t, &comp->bytecode, iter_case->pos + 3 + i) = pos.bytes[i];
-							}
+							if (!compiler_relocate(comp, iter_case->pos + 3, pos.u)) return false;
 							iter_pass++;
 						}
 						else {
-							if (!vector_push_back(control_data, &chain_vec, *iter_case)) {
-								__free_switch_vecs__;
-								goto FAILURE_CTRL_VECTOR;
-							}
+							if (!vector_push_back(control_data, chain_vec, *iter_case)) goto FAILURE_CTRL_VECTOR;
 							iter_pass++;
 						}
 					}
 
-					__free_switch_vecs__;
-					
 					if (!compiler_push_bytecode(comp, OP_ENDSWITCH)) return false;
-
-					#undef __free_switch_vecs__
 				} break;
 				case CTRL_FUNC: {
 					for (
-						control_data* iter = vector_at(control_data, temp_ctrl_vec, 1);
-						iter <= vector_back(control_data, temp_ctrl_vec);
+						control_data* iter = first_ctrl + 1;
+						iter < first_ctrl + count;
 						iter++
 					) {
 						switch (iter->ctrl) {
@@ -730,15 +1263,14 @@ bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
 						}
 					}
 					pos.u = current_ctrl.pos + 1;
-					for (int i = 0; i < 8; i++) {
-						*vector_at(uint8_t, &comp->bytecode, first_ctrl->pos + 1 + i) = pos.bytes[i];
-					}
+					if (!compiler_relocate(comp, first_ctrl->pos + 1, pos.u)) return false;
 					if (!compiler_push_bytecode(comp, OP_RETURN)) return false;
+					compiler_close_function(comp, first_ctrl->pos);
 				} break;
 				case CTRL_MACRO: {
 					for (
-						control_data* iter = vector_at(control_data, temp_ctrl_vec, 1);
-						iter <= vector_back(control_data, temp_ctrl_vec);
+						control_data* iter = first_ctrl + 1;
+						iter < first_ctrl + count;
 						iter++
 					) {
 						switch (iter->ctrl) {
@@ -751,57 +1283,49 @@ bool compiler_parse_control_words(compiler* comp, trie* trie_result) {
 						}
 					}
 					pos.u = current_ctrl.pos + 1;
-					for (int i = 0; i < 8; i++) {
-						*vector_at(uint8_t, &comp->bytecode, first_ctrl->pos + 1 + i) = pos.bytes[i];
-					}
+					if (!compiler_relocate(comp, first_ctrl->pos + 1, pos.u)) return false;
 					if (!compiler_push_bytecode(comp, OP_ENDMACRO)) return false;
-
+					compiler_close_function(comp, first_ctrl->pos);
+				} break;
+				case CTRL_IMMEDIATE: {
+					if (count > 1) goto FAILURE_CTRL;
+					compiler_resolve_relocations(comp);
+					if (!compiler_evaluate_immediate(comp, first_ctrl->pos)) return false;
 				} break;
 			}
-			vector_free(control_data, temp_ctrl_vec);
-			if (!vector_pop_back(cctl_ptr(vector(control_data)), &comp->control_data_stack)) goto FAILURE_CTRL_STACK;
+			if (!compiler_close_control(comp)) goto FAILURE_CTRL_VECTOR;
+			if (!comp->control_frames.size) compiler_resolve_relocations(comp);
 		} break;
 		case CTRL_IMPORT: {
-			char* current_filename;
-
-			char* token;
-			size_t index;
+			char import_filename[PATH_MAX];
 
 			if (comp->textcode_index_stack.size == 0) goto FAILURE_TEXTCODE;
-			index = *vector_back(size_t, &comp->textcode_index_stack);
-
 			if (comp->filename_vector.size == 0) goto FAILURE_TEXTCODE;
-			current_filename = *vector_at(cctl_ptr(char), &comp->filename_vector, index);
-
 			if (comp->preproc_tokens_vector.size == 0) goto FAILURE_PREPROC_STACK;
-			token = *vector_back(cctl_ptr(char), &comp->preproc_tokens_vector);
+			compiler_resolve_filename(comp, import_filename);
 
-			char import_filename[PATH_MAX];
+			dict_entry* filename_entry = dict_find(&comp->filename_dict, import_filename);
 
-		#ifdef _WIN32
-			char drive[_MAX_DRIVE];
-			char dir[_MAX_DIR];
-
-			_splitpath(current_filename, drive, dir, NULL, NULL);
-			_makepath(import_filename, drive, dir, token, NULL);
-		#else
-			char* dir = (char*) calloc(PATH_MAX, sizeof(char));
-			memcpy(dir, current_filename, strlen(current_filename) + 1);
-			dir = dirname(dir);
-			memcpy(import_filename, dir, strlen(dir) + 1);
-			free(dir);
-			strcat(import_filename, "/");
-			strcat(import_filename, token);
-		#endif
-			trie* filename_trie_result = trie_find(&comp->filename_trie, import_filename);
-
-			if (filename_trie_result) {
-				if (filename_trie_result->type == (uint8_t) true) {
+			if (filename_entry) {
+				if (filename_entry->type == (uint8_t) true) {
 					return true;
 				}
 			}
 
-			if (!compiler_compile_source(comp, import_filename)) return false;
+			if (compiler_object_file(import_filename)) {
+				if (!compiler_import_object(comp, import_filename)) return false;
+			}
+			else if (!compiler_compile_source(comp, import_filename)) return false;
+		} break;
+		case CTRL_EMBED: {
+			char embed_filename[PATH_MAX];
+
+			if (comp->textcode_index_stack.size == 0) goto FAILURE_TEXTCODE;
+			if (comp->filename_vector.size == 0) goto FAILURE_TEXTCODE;
+			if (comp->preproc_tokens_vector.size == 0) goto FAILURE_PREPROC_STACK;
+			compiler_resolve_filename(comp, embed_filename);
+
+			if (!compiler_embed_file(comp, embed_filename)) return false;
 		} break;
 	}
 
@@ -823,10 +1347,150 @@ FAILURE_TEXTCODE:
 	return false;
 }
 
+bool compiler_open_control(compiler* comp, control_data ctrl) {
+	if (!vector_push_back(size_t, &comp->control_frames, comp->control_entries.size)) return false;
+	return vector_push_back(control_data, &comp->control_entries, ctrl);
+}
+
+bool compiler_close_control(compiler* comp) {
+	size_t frame = *vector_back(size_t, &comp->control_frames);
+
+	vector_resize(control_data, &comp->control_entries, frame);
+	vector_pop_back(size_t, &comp->control_frames);
+	for (size_t i = 0; i < comp->control_pending.size; i++) {
+		if (!vector_push_back(control_data, &comp->control_entries, *vector_at(control_data, &comp->control_pending, i))) return false;
+	}
+	vector_clear(control_data, &comp->control_pending);
+	return true;
+}
+
+bool compiler_push_function(compiler* comp, control_data* ctrl) {
+	function_data func;
+
+	if (comp->keyword_value_pos + 9 != ctrl->pos) return true;
+
+	memcpy(&func.keyword, vector_at(uint8_t, &comp->bytecode, comp->keyword_value_pos + 1), sizeof(size_t));
+	func.ctrl = ctrl->ctrl;
+	func.begin = ctrl->pos;
+	func.end = 0;
+	func.toplevel = comp->control_frames.size == 1;
+	func.installed = false;
+
+	if (!vector_push_back(function_data, &comp->function_vector, func)) {
+		fputs("error : Function vector memory allocation failure\n", stderr);
+		return false;
+	}
+	return true;
+}
+
+void compiler_close_function(compiler* comp, size_t begin) {
+	for (size_t i = comp->function_vector.size - 1; i < -1; i--) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		if (func->begin == begin) {
+			func->end = comp->bytecode.size;
+			return;
+		}
+	}
+}
+
+bool compiler_verify_region(compiler* comp, size_t begin, size_t end) {
+	verifier checker;
+	bool result;
+
+	if (!verifier_init(&checker, comp->bytecode.p_data + begin, end - begin, begin, comp->constants.p_data, comp->constants.size)) {
+		fputs("error : Verifier memory allocation failure\n", stderr);
+		return false;
+	}
+	result = verifier_run(&checker, NULL, 0);
+	verifier_del(&checker);
+
+	if (!result) fputs("error : Immediate code verification failure\n", stderr);
+	return result;
+}
+
+bool compiler_evaluate_immediate(compiler* comp, size_t begin) {
+	interpreter inter;
+	rbt_node* node;
+
+	if (!compiler_verify_region(comp, begin, comp->bytecode.size)) return false;
+	if (!interpreter_init(&inter)) return false;
+	inter.bytecode = comp->bytecode.p_data;
+	inter.bytecode_size = comp->bytecode.size;
+	inter.constants = comp->constants.p_data;
+	inter.constants_size = comp->constants.size;
+	inter.track_allocations = true;
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		if (!func->end || func->begin >= begin) continue;
+		if (rbt_search(inter.global_words, func->keyword)) continue;
+		if (!compiler_verify_region(comp, func->begin, func->end)) goto FAILURE;
+		node = rbt_node_new(func->keyword);
+		if (!node) goto FAILURE_DEFINE;
+		node->data = func->begin + 9;
+		node->type = (func->ctrl == CTRL_FUNC) ? KWRD_FUNC : KWRD_MACRO;
+		rbt_insert(inter.global_words, node);
+	}
+
+	if (!interpreter_execute(&inter, begin, comp->bytecode.size)) goto FAILURE_EXECUTE;
+	for (size_t i = 0; i < inter.data_stack.size; i++) {
+		if (interpreter_owns_address(&inter, *vector_at(value, &inter.data_stack, i))) goto FAILURE_ADDRESS;
+	}
+
+	while (comp->function_vector.size) {
+		if (vector_back(function_data, &comp->function_vector)->begin < begin) break;
+		vector_pop_back(function_data, &comp->function_vector);
+	}
+	while (comp->keyword_sites.size) {
+		if (*vector_back(size_t, &comp->keyword_sites) < begin) break;
+		vector_pop_back(size_t, &comp->keyword_sites);
+	}
+	while (comp->line_rows.size) {
+		if (vector_back(line_row, &comp->line_rows)->offset <= begin) break;
+		vector_pop_back(line_row, &comp->line_rows);
+	}
+	while (comp->relocations.size) {
+		if (vector_back(relocation, &comp->relocations)->site < begin) break;
+		vector_pop_back(relocation, &comp->relocations);
+	}
+	comp->relocations_resolved = comp->relocations.size;
+	vector_resize(uint8_t, &comp->bytecode, begin);
+	comp->keyword_value_pos = SIZE_MAX;
+
+	for (size_t i = 0; i < inter.data_stack.size; i++) {
+		if (!compiler_push_bytecode_with_value(comp, OP_VALUE, *vector_at(value, &inter.data_stack, i))) {
+			interpreter_del(&inter);
+			return false;
+		}
+	}
+
+	interpreter_del(&inter);
+	return true;
+
+FAILURE_DEFINE:
+	interpreter_del(&inter);
+	fputs("error : Immediate dictionary memory allocation failure\n", stderr);
+	return false;
+
+FAILURE_ADDRESS:
+	interpreter_del(&inter);
+	fputs("error : Immediate result holds a compile-time address\n", stderr);
+	return false;
+
+FAILURE:
+	interpreter_del(&inter);
+	return false;
+
+FAILURE_EXECUTE:
+	interpreter_del(&inter);
+	fputs("error : Immediate evaluation failure\n", stderr);
+	return false;
+}
+
 bool compiler_parse_keyword_value(compiler* comp, char* token) {
-	trie* word;
+	dict_entry* word;
 	
-	word = trie_find(&comp->dictionary, token);
+	word = dict_find(&comp->dictionary, token);
 
 	if (word) {
 		if (word->type != WTT_KWRD) {
@@ -859,7 +1523,7 @@ bool compiler_parse_keyword_value(compiler* comp, char* token) {
 		}
 
 		comp->dictionary_keyword_count++;
-		word = trie_insert(&comp->dictionary, token, WTT_KWRD);
+		word = dict_insert(&comp->dictionary, token, WTT_KWRD);
 		if (!word) {
 			fputs("error : Dictionary memory allocation failure\n", stderr);
 			return false;
@@ -867,6 +1531,11 @@ bool compiler_parse_keyword_value(compiler* comp, char* token) {
 		word->data.u = comp->dictionary_keyword_count;
 	}
 
+	comp->keyword_value_pos = comp->bytecode.size;
+	if (!vector_push_back(size_t, &comp->keyword_sites, comp->bytecode.size)) {
+		fputs("error : Keyword site vector memory allocation failure\n", stderr);
+		return false;
+	}
 	if (!compiler_push_bytecode_with_value(comp, OP_VALUE, word->data)) return false;
 
 	return true;
@@ -952,15 +1621,12 @@ bool compiler_parse_num(compiler* comp, char* token) {
 	return result;
 }
 
-bool compiler_parse_char(compiler* comp, char* token, bool push_length) {
+bool compiler_decode_string(compiler* comp, char* token, vector(value)* value_reverser) {
 	value v;
 
 	int num_parse_count;
 	int num_parse_max;
 
-	vector(value) value_reverser;
-	vector_init(value, &value_reverser);
-
 	char* end = token + strlen(token) + 1;
 
 	while (*token) {
@@ -1042,7 +1708,6 @@ bool compiler_parse_char(compiler* comp, char* token, bool push_length) {
 				}
 			}
 			else if ((*token == '\'') || (*token == '\"')) {
-				vector_free(value, &value_reverser);
 				fputs("error : String parse failure\n", stderr);
 				return false;
 			}
@@ -1062,57 +1727,221 @@ bool compiler_parse_char(compiler* comp, char* token, bool push_length) {
 			token += rc;
 			v.u = out;
 		}
-		if (!vector_push_back(value, &value_reverser, v)) goto FAILURE_VECTOR;
-	}
-	
-	for (size_t i = value_reverser.size - 1; i < -1; i--) {
-		if (!compiler_push_bytecode_with_value(comp, OP_VALUE, *vector_at(value, &value_reverser, i))) return false;
-	}
-
-	if (push_length) {
-		v.u = value_reverser.size;
-		if (!compiler_push_bytecode_with_value(comp, OP_VALUE, v)) return false;
+		if (!vector_push_back(value, value_reverser, v)) goto FAILURE_VECTOR;
 	}
-
-	vector_free(value, &value_reverser);
 	return true;
 
 FAILURE_ESCAPE:
-	vector_free(value, &value_reverser);
 	fputs("error : Escape sequence parsing faliure\n", stderr);
 	return false;
 
 FAILURE_UNICODE:
-	vector_free(value, &value_reverser);
 	fputs("error : Unicode decoding faliure\n", stderr);
 	return false;
 
 FAILURE_VECTOR:
-	vector_free(value, &value_reverser);
 	fputs("error : Unicode inserter vector memory allocation failure\n", stderr);
 	return false;
 }
 
-bool compiler_push_bytecode(compiler* comp, opcode op) {
-	if (!vector_push_back(uint8_t, &comp->bytecode, (uint8_t) op)) {
-		fputs("error : Bytecode memory allocation faliure\n", stderr);
+void compiler_resolve_filename(compiler* comp, char* filename) {
+	size_t index = *vector_back(size_t, &comp->textcode_index_stack);
+	char* current_filename = *vector_at(cctl_ptr(char), &comp->filename_vector, index);
+	char* token = *vector_back(cctl_ptr(char), &comp->preproc_tokens_vector);
+
+	compiler_join_filename(current_filename, token, filename);
+}
+
+void compiler_join_filename(char* current_filename, char* token, char* filename) {
+#ifdef _WIN32
+	char drive[_MAX_DRIVE];
+	char dir[_MAX_DIR];
+
+	_splitpath(current_filename, drive, dir, NULL, NULL);
+	_makepath(filename, drive, dir, token, NULL);
+#else
+	char* dir = (char*) calloc(PATH_MAX, sizeof(char));
+	memcpy(dir, current_filename, strlen(current_filename) + 1);
+	dir = dirname(dir);
+	memcpy(filename, dir, strlen(dir) + 1);
+	free(dir);
+	strcat(filename, "/");
+	strcat(filename, token);
+#endif
+}
+
+bool compiler_embed_file(compiler* comp, char* filename) {
+	FILE* file;
+	long size;
+	size_t offset = comp->constants.size;
+	size_t padded;
+	value v;
+
+	file = fopen(filename, "rb");
+	if (!file) goto FAILURE_OPEN;
+
+	if (fseek(file, 0, SEEK_END)) goto FAILURE_READ;
+	size = ftell(file);
+	if (size < 0) goto FAILURE_READ;
+	rewind(file);
+
+	padded = (size + sizeof(value) - 1) & ~(sizeof(value) - 1);
+	if (!vector_resize(uint8_t, &comp->constants, offset + sizeof(value) + padded)) goto FAILURE_ALLOC;
+	memset(vector_at(uint8_t, &comp->constants, offset), 0, sizeof(value) + padded);
+	bytecode_store_u64(vector_at(uint8_t, &comp->constants, offset), size);
+	if (size && (fread(vector_at(uint8_t, &comp->constants, offset + sizeof(value)), size, 1, file) != 1)) goto FAILURE_READ;
+	fclose(file);
+
+	if (!compiler_add_dependency(comp, filename)) goto FAILURE_DEPENDENCY;
+
+	v.u = offset;
+	return compiler_push_bytecode_with_value(comp, OP_DATA, v);
+
+FAILURE_OPEN:
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename);
+	fputs("error : Embedded file reading failure\n", stderr);
+	return false;
+FAILURE_READ:
+	fclose(file);
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename);
+	fputs("error : Embedded file reading failure\n", stderr);
+	return false;
+FAILURE_ALLOC:
+	fclose(file);
+	fputs("error : Constant data memory allocation failure\n", stderr);
+	return false;
+FAILURE_DEPENDENCY:
+	fputs("error : Dependency vector memory allocation failure\n", stderr);
+	return false;
+}
+
+bool compiler_add_dependency(compiler* comp, char* filename) {
+	size_t filename_size = strlen(filename) + 1;
+	char* temp = (char*) malloc(filename_size);
+
+	if (!temp) return false;
+	memcpy(temp, filename, filename_size);
+	if (!vector_push_back(cctl_ptr(char), &comp->dependency_vector, temp)) {
+		free(temp);
 		return false;
 	}
 	return true;
 }
 
-bool compiler_push_bytecode_with_value(compiler* comp, opcode op, value v) {
-	if (!vector_push_back(uint8_t, &comp->bytecode, (uint8_t) op)) goto FAILURE;
+bool compiler_push_constant_string(compiler* comp, vector(value)* values, value* offset) {
+	uint8_t cell[8];
+
+	offset->u = comp->constants.size;
+	bytecode_store_u64(cell, values->size);
 	for (int i = 0; i < 8; i++) {
-		if (!vector_push_back(uint8_t, &comp->bytecode, v.bytes[i])) goto FAILURE;
+		if (!vector_push_back(uint8_t, &comp->constants, cell[i])) goto FAILURE;
+	}
+	for (size_t i = 0; i < values->size; i++) {
+		bytecode_store_u64(cell, vector_at(value, values, i)->u);
+		for (int j = 0; j < 8; j++) {
+			if (!vector_push_back(uint8_t, &comp->constants, cell[j])) goto FAILURE;
+		}
 	}
 	return true;
 
 FAILURE:
-	fputs("error : Bytecode memory allocation faliure\n", stderr);
+	fputs("error : Constant data memory allocation failure\n", stderr);
 	return false;
 }
 
+bool compiler_parse_char(compiler* comp, char* token, bool push_length) {
+	vector(value) value_reverser;
+	value v;
+	bool result = false;
+
+	vector_init(value, &value_reverser);
+	if (!compiler_decode_string(comp, token, &value_reverser)) goto END;
+
+	if (push_length && value_reverser.size) {
+		if (!compiler_push_constant_string(comp, &value_reverser, &v)) goto END;
+		if (!compiler_push_bytecode_with_value(comp, OP_PUSHDATA, v)) goto END;
+		result = true;
+		goto END;
+	}
+
+	for (size_t i = value_reverser.size; i-- > 0; ) {
+		if (!compiler_push_bytecode_with_value(comp, OP_VALUE, *vector_at(value, &value_reverser, i))) goto END;
+	}
+
+	if (push_length) {
+		v.u = value_reverser.size;
+		if (!compiler_push_bytecode_with_value(comp, OP_VALUE, v)) goto END;
+	}
+	result = true;
+
+END:
+	vector_free(value, &value_reverser);
+	return result;
+}
+
+bool compiler_parse_data(compiler* comp, char* token) {
+	vector(value) values;
+	value v;
+	bool result = false;
+
+	vector_init(value, &values);
+	if (!compiler_decode_string(comp, token, &values)) goto END;
+	if (!compiler_push_constant_string(comp, &values, &v)) goto END;
+	if (!compiler_push_bytecode_with_value(comp, OP_DATA, v)) goto END;
+	result = true;
+
+END:
+	vector_free(value, &values);
+	return result;
+}
+
+bool compiler_emit(compiler* comp, const uint8_t* data, size_t size) {
+	size_t offset = comp->bytecode.size;
+
+	if (!vector_resize(uint8_t, &comp->bytecode, offset + size)) {
+		fputs("error : Bytecode memory allocation faliure\n", stderr);
+		return false;
+	}
+	memcpy(comp->bytecode.p_data + offset, data, size);
+	return true;
+}
+
+bool compiler_relocate(compiler* comp, size_t site, size_t target) {
+	relocation reloc;
+
+	reloc.site = site;
+	reloc.target = target;
+	if (!vector_push_back(relocation, &comp->relocations, reloc)) {
+		fputs("error : Relocation vector memory allocation failure\n", stderr);
+		return false;
+	}
+	return true;
+}
+
+void compiler_resolve_relocations(compiler* comp) {
+	value target;
+
+	for (size_t i = comp->relocations_resolved; i < comp->relocations.size; i++) {
+		relocation* reloc = vector_at(relocation, &comp->relocations, i);
+		target.u = reloc->target;
+		memcpy(comp->bytecode.p_data + reloc->site, target.bytes, sizeof(value));
+	}
+	comp->relocations_resolved = comp->relocations.size;
+}
+
+bool compiler_push_bytecode(compiler* comp, opcode op) {
+	uint8_t code = (uint8_t) op;
+	return compiler_emit(comp, &code, 1);
+}
+
+bool compiler_push_bytecode_with_value(compiler* comp, opcode op, value v) {
+	uint8_t code[9];
+
+	code[0] = (uint8_t) op;
+	memcpy(code + 1, v.bytes, sizeof(value));
+	return compiler_emit(comp, code, sizeof(code));
+}
+
 bool compiler_push_bytecode_with_null(compiler* comp, opcode op) {
 	value v;
 	v.u = 0;
@@ -1121,9 +1950,9 @@ bool compiler_push_bytecode_with_null(compiler* comp, opcode op) {
 
 bool compiler_push_preproc_token(compiler* comp, char* token) {
 	size_t len = strlen(token) + 1;
-	char* temp = (char*) malloc(len * sizeof(char));
+	char* temp = (char*) arena_alloc(&comp->arena, len * sizeof(char));
 	if (!temp) goto FAILURE_ALLOC;
-	strcpy(temp, token);
+	memcpy(temp, token, len);
 	if (!vector_push_back(cctl_ptr(char), &comp->preproc_tokens_vector, temp)) goto FAILURE_VECTOR;
 	return true;
 
@@ -1133,6 +1962,5 @@ FAILURE_ALLOC:
 	
 FAILURE_VECTOR:
 	fputs("error : Preprocessor tokens vector memory allocation failure\n", stderr);
-	free(temp);
 	return false;
 }
\ No newline at end of file
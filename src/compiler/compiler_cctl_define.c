@@ -3,6 +3,16 @@
 vector_imp_c(cctl_ptr(char));
 vector_imp_c(uint8_t);
 vector_imp_c(control_data);
-vector_imp_c(cctl_ptr(vector(control_data)));
-vector_imp_c(value);
-vector_imp_c(size_t);
\ No newline at end of file
+vector_imp_c(relocation);
+vector_imp_c(function_data);
+vector_imp_c(instruction);
+vector_imp_c(keyword_use);
+vector_imp_c(specialization);
+vector_imp_c(function_hash);
+vector_imp_c(line_row);
+vector_imp_c(token);
+vector_imp_c(size_t);
+vector_imp_c(uint64_t);
+vector_imp_c(report_entry);
+vector_imp_c(report_frame);
+vector_imp_c(cctl_ptr(source_file));
\ No newline at end of file
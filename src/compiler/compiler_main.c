@@ -5,16 +5,31 @@
 int main(int argc, char* argv[]) {
 	
 	compiler comp;
-	char* output_filename;
+	char* input_filename = NULL;
+	char* output_filename = NULL;
 	if (!compiler_init(&comp)) return 1;
+	comp.options.program_filename = argv[0];
 
-	if (argc == 1) {
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-c")) comp.options.object = true;
+		else if (!strcmp(argv[i], "-g")) comp.options.debug = true;
+		else if (!strncmp(argv[i], "--", 2)) {
+			if (!compiler_parse_option(&comp, argv[i] + 2)) {
+				fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", argv[i]);
+				fputs("error : Invalid option\n", stderr);
+				return 2;
+			}
+		}
+		else if (!input_filename) input_filename = argv[i];
+		else output_filename = argv[i];
+	}
+
+	if (!input_filename) {
 		fputs("error : No input files\n", stderr);
 		return 2;
 	}
-	if (argc == 2) output_filename = "out.sabre";
-	else output_filename = argv[2];
-	if (!compiler_compile(&comp, argv[1], output_filename)) {
+	if (!output_filename) output_filename = comp.options.object ? "out.sabro" : "out.sabre";
+	if (!compiler_compile(&comp, input_filename, output_filename)) {
 		fputs("error : Compilation failure\n", stderr);
 		return 3;
 	}
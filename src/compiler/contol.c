@@ -14,7 +14,9 @@ const char* control_names[] = {
 	"func",
 	"macro",
 	"return",
-	"import"
+	"import",
+	"immediate",
+	"embed"
 };
 
 size_t control_len = sizeof(control_names) / sizeof(char*);
\ No newline at end of file
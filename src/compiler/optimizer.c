@@ -0,0 +1,1534 @@
+#include "compiler.h"
+
+bool instruction_has_operand(uint8_t op) {
+	switch (op) {
+		case OP_VALUE:
+		case OP_IF:
+		case OP_JUMP:
+		case OP_FUNC:
+		case OP_MACRO:
+		case OP_ALIAS:
+		case OP_CALL:
+		case OP_DATA:
+		case OP_PUSHDATA: {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool instruction_is_branch(uint8_t op) {
+	switch (op) {
+		case OP_IF:
+		case OP_JUMP:
+		case OP_FUNC:
+		case OP_MACRO:
+		case OP_ALIAS: {
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t instruction_size(instruction* inst) {
+	return instruction_has_operand(inst->op) ? 9 : 1;
+}
+
+bool instruction_fits(int64_t x, size_t width) {
+	if (width >= 8) return true;
+	int64_t limit = (int64_t) 1 << (width * 8 - 1);
+	return (x >= -limit) && (x < limit);
+}
+
+uint8_t instruction_unsigned_opcode(uint8_t op, uint8_t narrow, uint64_t x) {
+	if (x <= UINT8_MAX) return narrow;
+	if (x <= UINT16_MAX) return narrow + 1;
+	if (x <= UINT32_MAX) return narrow + 2;
+	return op;
+}
+
+uint8_t instruction_compact_opcode(instruction* inst) {
+	switch (inst->op) {
+		case OP_VALUE: {
+			if (inst->operand.i == 0) return OP_VALUE_ZERO;
+			if (inst->operand.i == 1) return OP_VALUE_ONE;
+			if (instruction_fits(inst->operand.i, 1)) return OP_VALUE_8;
+			if (instruction_fits(inst->operand.i, 2)) return OP_VALUE_16;
+			if (instruction_fits(inst->operand.i, 4)) return OP_VALUE_32;
+			return OP_VALUE;
+		}
+		case OP_CALL: {
+			return instruction_unsigned_opcode(inst->op, OP_CALL_8, inst->operand.u);
+		}
+		case OP_DATA: {
+			return instruction_unsigned_opcode(inst->op, OP_DATA_8, inst->operand.u);
+		}
+		case OP_PUSHDATA: {
+			return instruction_unsigned_opcode(inst->op, OP_PUSHDATA_8, inst->operand.u);
+		}
+		case OP_IF: {
+			return OP_IF_8;
+		}
+		case OP_JUMP: {
+			return OP_JUMP_8;
+		}
+		case OP_FUNC: {
+			return OP_FUNC_8;
+		}
+		case OP_MACRO: {
+			return OP_MACRO_8;
+		}
+		case OP_ALIAS: {
+			return OP_ALIAS_8;
+		}
+	}
+	return inst->op;
+}
+
+uint8_t instruction_widen_opcode(uint8_t op) {
+	static const uint8_t fixed[] = {OP_IF, OP_JUMP, OP_FUNC, OP_MACRO, OP_ALIAS};
+	if ((op - OP_IF_8) % 3 == 2) return fixed[(op - OP_IF_8) / 3];
+	return op + 1;
+}
+
+int instruction_fold_arity(uint8_t op) {
+	switch (op) {
+		case OP_NEG:
+		case OP_INC:
+		case OP_DEC:
+		case OP_NOT:
+		case OP_FNEG:
+		case OP_STOF:
+		case OP_UTOF:
+		case OP_FTOS:
+		case OP_FTOU:
+		case OP_DROP:
+		case OP_DUP: {
+			return 1;
+		}
+		case OP_ADD:
+		case OP_SUB:
+		case OP_MUL:
+		case OP_DIV:
+		case OP_MOD:
+		case OP_UDIV:
+		case OP_UMOD:
+		case OP_EQU:
+		case OP_NEQ:
+		case OP_GRT:
+		case OP_GEQ:
+		case OP_LST:
+		case OP_LEQ:
+		case OP_UGRT:
+		case OP_UGEQ:
+		case OP_ULST:
+		case OP_ULEQ:
+		case OP_FADD:
+		case OP_FSUB:
+		case OP_FMUL:
+		case OP_FDIV:
+		case OP_FMOD:
+		case OP_FEQU:
+		case OP_FNEQ:
+		case OP_FGRT:
+		case OP_FGEQ:
+		case OP_FLST:
+		case OP_FLEQ:
+		case OP_AND:
+		case OP_OR:
+		case OP_XOR:
+		case OP_LSFT:
+		case OP_RSFT:
+		case OP_NIP:
+		case OP_OVER:
+		case OP_TUCK:
+		case OP_SWAP:
+		case OP_TDROP:
+		case OP_TDUP: {
+			return 2;
+		}
+		case OP_ROT: {
+			return 3;
+		}
+		case OP_TNIP:
+		case OP_TOVER:
+		case OP_TTUCK:
+		case OP_TSWAP: {
+			return 4;
+		}
+		case OP_TROT: {
+			return 6;
+		}
+	}
+	return 0;
+}
+
+bool compiler_optimize(compiler* comp) {
+	vector(instruction) code;
+
+	vector_init(instruction, &code);
+
+	if (!compiler_decode(comp, &code)) goto FAILURE;
+	if (comp->options.release_sources) vector_free(uint8_t, &comp->bytecode);
+	if (comp->options.specialize_budget) {
+		if (!compiler_specialize(comp, &code)) goto FAILURE;
+	}
+	if (comp->options.scratch_alloc) {
+		if (!compiler_scratch_alloc(comp, &code)) goto FAILURE;
+	}
+	if (comp->options.merge_functions) {
+		if (!compiler_merge_functions(comp, &code)) goto FAILURE;
+	}
+	if (comp->options.layout != LAYOUT_SOURCE) {
+		if (!compiler_layout(comp, &code)) goto FAILURE;
+	}
+	if (!compiler_install_functions(comp, &code)) goto FAILURE;
+	if (!compiler_encode(comp, &code)) goto FAILURE;
+
+	vector_free(instruction, &code);
+	return true;
+
+FAILURE:
+	vector_free(instruction, &code);
+	return false;
+}
+
+size_t compiler_find_offset(vector(size_t)* offsets, size_t pos) {
+	size_t low = 0;
+	size_t high = offsets->size;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		size_t offset = *vector_at(size_t, offsets, mid);
+		if (offset == pos) return mid;
+		if (offset < pos) low = mid + 1;
+		else high = mid;
+	}
+	return SIZE_MAX;
+}
+
+bool compiler_decode(compiler* comp, vector(instruction)* code) {
+	vector(size_t) offsets;
+	instruction inst;
+	size_t site = 0;
+	size_t row = 0;
+	size_t pos = 0;
+
+	vector_init(size_t, &offsets);
+
+	while (pos < comp->bytecode.size) {
+		inst.op = *vector_at(uint8_t, &comp->bytecode, pos);
+		inst.operand.u = 0;
+		inst.target = 0;
+		inst.keyword = false;
+		inst.label = false;
+		inst.source = SIZE_MAX;
+		if (instruction_has_operand(inst.op)) {
+			if (pos + 9 > comp->bytecode.size) goto FAILURE_BYTECODE;
+			memcpy(inst.operand.bytes, vector_at(uint8_t, &comp->bytecode, pos + 1), 8);
+		}
+		while ((site < comp->keyword_sites.size) && (*vector_at(size_t, &comp->keyword_sites, site) < pos)) site++;
+		if (site < comp->keyword_sites.size) {
+			if (*vector_at(size_t, &comp->keyword_sites, site) == pos) inst.keyword = true;
+		}
+		while ((row + 1 < comp->line_rows.size) && (vector_at(line_row, &comp->line_rows, row + 1)->offset <= pos)) row++;
+		if (comp->line_rows.size && (vector_at(line_row, &comp->line_rows, row)->offset <= pos)) inst.source = row;
+		if (!vector_push_back(size_t, &offsets, pos)) goto FAILURE_VECTOR;
+		if (!vector_push_back(instruction, code, inst)) goto FAILURE_VECTOR;
+		pos += instruction_size(&inst);
+	}
+	if (!vector_push_back(size_t, &offsets, pos)) goto FAILURE_VECTOR;
+
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if (!instruction_is_branch(iter->op)) continue;
+		iter->target = compiler_find_offset(&offsets, iter->operand.u);
+		if (iter->target == SIZE_MAX) goto FAILURE_BYTECODE;
+	}
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		func->begin = compiler_find_offset(&offsets, func->begin);
+		func->end = compiler_find_offset(&offsets, func->end);
+		if ((func->begin == SIZE_MAX) || (func->end == SIZE_MAX)) goto FAILURE_BYTECODE;
+	}
+
+	compiler_mark_labels(code);
+
+	vector_free(size_t, &offsets);
+	return true;
+
+FAILURE_BYTECODE:
+	vector_free(size_t, &offsets);
+	fputs("error : Malformed bytecode\n", stderr);
+	return false;
+
+FAILURE_VECTOR:
+	vector_free(size_t, &offsets);
+	fputs("error : Instruction vector memory allocation failure\n", stderr);
+	return false;
+}
+
+size_t compiler_literal_run(vector(instruction)* code, size_t begin) {
+	size_t end = begin;
+
+	while (end < code->size) {
+		instruction* iter = vector_at(instruction, code, end);
+		if ((iter->op != OP_VALUE) || iter->keyword) break;
+		if (iter->label && (end > begin)) break;
+		end++;
+	}
+	return end - begin;
+}
+
+bool compiler_encode(compiler* comp, vector(instruction)* code) {
+	vector(size_t) offsets;
+	uint8_t* ops;
+	size_t* runs;
+	size_t pos = 0;
+	bool changed = true;
+
+	if (!compiler_compact(code, &comp->function_vector)) return false;
+
+	vector_init(size_t, &offsets);
+	ops = (uint8_t*) malloc(code->size + 1);
+	runs = (size_t*) calloc(code->size + 1, sizeof(size_t));
+	if (!(ops && runs)) goto FAILURE_VECTOR;
+	if (!vector_reserve(size_t, &offsets, code->size + 1)) goto FAILURE_VECTOR;
+
+	compiler_mark_labels(code);
+	for (size_t i = 0; i < code->size; ) {
+		size_t count = compiler_literal_run(code, i);
+		if (count < VALUES_RUN_MIN) {
+			ops[i] = instruction_compact_opcode(vector_at(instruction, code, i));
+			i++;
+			continue;
+		}
+		runs[i] = count;
+		ops[i] = instruction_unsigned_opcode(OP_VALUES, OP_VALUES_8, count);
+		for (size_t j = 1; j < count; j++) {
+			ops[i + j] = OP_NONE;
+		}
+		i += count;
+	}
+
+	while (changed) {
+		changed = false;
+		pos = 0;
+		vector_clear(size_t, &offsets);
+		for (size_t i = 0; i < code->size; i++) {
+			vector_push_back(size_t, &offsets, pos);
+			if (ops[i] != OP_NONE) pos += 1 + opcode_operand_size(ops[i]) + runs[i] * sizeof(value);
+		}
+		vector_push_back(size_t, &offsets, pos);
+
+		for (size_t i = 0; i < code->size; i++) {
+			instruction* iter = vector_at(instruction, code, i);
+			int64_t relative;
+			if (!opcode_is_relative(ops[i])) continue;
+			relative = *vector_at(size_t, &offsets, iter->target) - *vector_at(size_t, &offsets, i + 1);
+			if (instruction_fits(relative, opcode_operand_size(ops[i]))) continue;
+			ops[i] = instruction_widen_opcode(ops[i]);
+			changed = true;
+		}
+	}
+
+	vector_clear(size_t, &comp->keyword_sites);
+	vector_clear(relocation, &comp->relocations);
+	comp->relocations_resolved = 0;
+	if (!vector_resize(uint8_t, &comp->bytecode, pos)) goto FAILURE_VECTOR;
+
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		size_t offset = *vector_at(size_t, &offsets, i);
+		uint8_t* out = vector_at(uint8_t, &comp->bytecode, offset);
+		value operand = iter->operand;
+
+		if (ops[i] == OP_NONE) continue;
+		if (instruction_is_branch(iter->op)) operand.u = *vector_at(size_t, &offsets, iter->target);
+		if (opcode_is_relative(ops[i])) operand.u -= *vector_at(size_t, &offsets, i + 1);
+		if (runs[i]) operand.u = runs[i];
+		*out = ops[i];
+		bytecode_store_width(out + 1, operand.u, opcode_operand_size(ops[i]));
+		out += 1 + opcode_operand_size(ops[i]);
+		for (size_t j = 0; j < runs[i]; j++) {
+			bytecode_store_u64(out + j * sizeof(value), vector_at(instruction, code, i + j)->operand.u);
+		}
+		if (iter->keyword) {
+			if (!vector_push_back(size_t, &comp->keyword_sites, offset)) goto FAILURE_VECTOR;
+		}
+	}
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		func->begin = *vector_at(size_t, &offsets, func->begin);
+		func->end = *vector_at(size_t, &offsets, func->end);
+	}
+	if (!compiler_encode_lines(comp, code, ops, &offsets)) goto FAILURE_VECTOR;
+	comp->keyword_value_pos = SIZE_MAX;
+
+	vector_free(size_t, &offsets);
+	free(ops);
+	free(runs);
+	return true;
+
+FAILURE_VECTOR:
+	vector_free(size_t, &offsets);
+	free(ops);
+	free(runs);
+	fputs("error : Bytecode memory allocation failure\n", stderr);
+	return false;
+}
+
+bool compiler_encode_lines(compiler* comp, vector(instruction)* code, uint8_t* ops, vector(size_t)* offsets) {
+	vector(line_row) lines;
+	size_t last = SIZE_MAX;
+
+	vector_init(line_row, &lines);
+	for (size_t i = 0; i < code->size; i++) {
+		size_t source = vector_at(instruction, code, i)->source;
+		line_row row;
+		if ((ops[i] == OP_NONE) || (source == SIZE_MAX) || (source == last)) continue;
+		row = *vector_at(line_row, &comp->line_rows, source);
+		row.offset = *vector_at(size_t, offsets, i);
+		if (!vector_push_back(line_row, &lines, row)) {
+			vector_free(line_row, &lines);
+			return false;
+		}
+		last = source;
+	}
+
+	vector_free(line_row, &comp->line_rows);
+	comp->line_rows = lines;
+	return true;
+}
+
+bool compiler_compact(vector(instruction)* code, vector(function_data)* functions) {
+	size_t live = 0;
+	size_t* map = (size_t*) malloc((code->size + 1) * sizeof(size_t));
+	if (!map) {
+		fputs("error : Instruction map memory allocation failure\n", stderr);
+		return false;
+	}
+
+	for (size_t i = 0; i < code->size; i++) {
+		map[i] = live;
+		if (vector_at(instruction, code, i)->op == OP_NONE) continue;
+		*vector_at(instruction, code, live) = *vector_at(instruction, code, i);
+		live++;
+	}
+	map[code->size] = live;
+
+	for (size_t i = 0; i < live; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if (instruction_is_branch(iter->op)) iter->target = map[iter->target];
+	}
+
+	if (functions) {
+		for (size_t i = 0; i < functions->size; i++) {
+			function_data* func = vector_at(function_data, functions, i);
+			func->begin = map[func->begin];
+			func->end = map[func->end];
+		}
+	}
+
+	vector_resize(instruction, code, live);
+	free(map);
+	return true;
+}
+
+void compiler_mark_labels(vector(instruction)* code) {
+	for (size_t i = 0; i < code->size; i++) {
+		vector_at(instruction, code, i)->label = false;
+	}
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if (!instruction_is_branch(iter->op)) continue;
+		if (iter->target < code->size) vector_at(instruction, code, iter->target)->label = true;
+		if ((iter->op == OP_FUNC) || (iter->op == OP_MACRO)) {
+			if (i + 1 < code->size) vector_at(instruction, code, i + 1)->label = true;
+		}
+	}
+}
+
+int compiler_compare_keyword_use(const void* a, const void* b) {
+	const keyword_use* x = (const keyword_use*) a;
+	const keyword_use* y = (const keyword_use*) b;
+	if (x->keyword != y->keyword) return (x->keyword < y->keyword) ? -1 : 1;
+	if (x->index != y->index) return (x->index < y->index) ? -1 : 1;
+	return 0;
+}
+
+bool compiler_collect_keyword_uses(vector(instruction)* code, vector(keyword_use)* uses) {
+	keyword_use use;
+
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if ((iter->op == OP_VALUE) && iter->keyword) {
+			use.store = (i + 1 < code->size) ? (vector_at(instruction, code, i + 1)->op == OP_TO) : false;
+		}
+		else if (iter->op == OP_CALL) {
+			use.store = false;
+		}
+		else continue;
+		use.keyword = iter->operand.u;
+		use.index = i;
+		use.op = iter->op;
+		if (!vector_push_back(keyword_use, uses, use)) {
+			fputs("error : Keyword use vector memory allocation failure\n", stderr);
+			return false;
+		}
+	}
+
+	if (uses->size) qsort(uses->p_data, uses->size, sizeof(keyword_use), compiler_compare_keyword_use);
+	return true;
+}
+
+size_t compiler_find_keyword_use(vector(keyword_use)* uses, size_t keyword) {
+	size_t low = 0;
+	size_t high = uses->size;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		if (vector_at(keyword_use, uses, mid)->keyword < keyword) low = mid + 1;
+		else high = mid;
+	}
+	return low;
+}
+
+bool compiler_local_keyword(vector(keyword_use)* uses, size_t keyword, function_data* func, bool* read_outside) {
+	size_t low = compiler_find_keyword_use(uses, keyword);
+	size_t stores = 0;
+
+	*read_outside = false;
+	for (size_t i = low; i < uses->size; i++) {
+		keyword_use* use = vector_at(keyword_use, uses, i);
+		bool inside = (use->index > func->begin) && (use->index < func->end);
+		if (use->keyword != keyword) break;
+		if (use->op == OP_VALUE) {
+			if (!(use->store && inside)) return false;
+			stores++;
+		}
+		else if (!inside) *read_outside = true;
+	}
+
+	return stores == 1;
+}
+
+bool compiler_variable_keyword(vector(instruction)* code, vector(keyword_use)* uses, size_t keyword) {
+	for (size_t i = compiler_find_keyword_use(uses, keyword); i < uses->size; i++) {
+		keyword_use* use = vector_at(keyword_use, uses, i);
+		instruction* next;
+		if (use->keyword != keyword) break;
+		if (use->op != OP_VALUE) continue;
+		if (use->index + 1 >= code->size) return true;
+		next = vector_at(instruction, code, use->index + 1);
+		if (!((next->op == OP_FUNC) || (next->op == OP_MACRO))) return true;
+	}
+	return false;
+}
+
+int compiler_compare_function(const void* a, const void* b) {
+	const function_data* x = (const function_data*) a;
+	const function_data* y = (const function_data*) b;
+	if (x->keyword != y->keyword) return (x->keyword < y->keyword) ? -1 : 1;
+	return 0;
+}
+
+bool compiler_sort_functions(vector(instruction)* code, vector(function_data)* functions, vector(function_data)* sorted) {
+	for (size_t i = 0; i < functions->size; i++) {
+		function_data func = *vector_at(function_data, functions, i);
+		for (size_t j = func.begin + 1; j < func.end; j++) {
+			uint8_t op = vector_at(instruction, code, j)->op;
+			if ((op == OP_FUNC) || (op == OP_MACRO)) {
+				func.ctrl = CTRL_END;
+				break;
+			}
+		}
+		if (!vector_push_back(function_data, sorted, func)) {
+			fputs("error : Function vector memory allocation failure\n", stderr);
+			return false;
+		}
+	}
+
+	if (!sorted->size) return true;
+	qsort(sorted->p_data, sorted->size, sizeof(function_data), compiler_compare_function);
+
+	for (size_t i = 1; i < sorted->size; i++) {
+		function_data* prev = vector_at(function_data, sorted, i - 1);
+		function_data* func = vector_at(function_data, sorted, i);
+		if (prev->keyword == func->keyword) {
+			prev->ctrl = CTRL_END;
+			func->ctrl = CTRL_END;
+		}
+	}
+	return true;
+}
+
+function_data* compiler_find_function(vector(function_data)* sorted, size_t keyword) {
+	function_data key;
+	function_data* func;
+
+	if (!sorted->size) return NULL;
+	key.keyword = keyword;
+	func = (function_data*) bsearch(&key, sorted->p_data, sorted->size, sizeof(function_data), compiler_compare_function);
+	if (!func) return NULL;
+	if ((func->ctrl == CTRL_END) || !func->end) return NULL;
+	return func;
+}
+
+bool compiler_specialize(compiler* comp, vector(instruction)* code) {
+	interpreter inter;
+	vector(function_data) sorted;
+	vector(function_data) clone_functions;
+	vector(keyword_use) uses;
+	vector(specialization) specs;
+	vector(instruction) clones;
+	vector(instruction) clone;
+	size_t budget = comp->options.specialize_budget;
+	bool result = false;
+
+	if (!interpreter_init(&inter)) return false;
+
+	vector_init(function_data, &sorted);
+	vector_init(function_data, &clone_functions);
+	vector_init(keyword_use, &uses);
+	vector_init(specialization, &specs);
+	vector_init(instruction, &clones);
+	vector_init(instruction, &clone);
+
+	if (!compiler_sort_functions(code, &comp->function_vector, &sorted)) goto END;
+	if (!compiler_collect_keyword_uses(code, &uses)) goto END;
+
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* call = vector_at(instruction, code, i);
+		function_data* func;
+		specialization spec;
+		size_t first = i;
+		size_t keyword = 0;
+
+		if (call->op != OP_CALL) continue;
+		func = compiler_find_function(&sorted, call->operand.u);
+		if (!func || (func->ctrl != CTRL_FUNC)) continue;
+
+		spec.begin = func->begin;
+		spec.count = 0;
+		while (
+			(spec.count < SPECIALIZE_ARGS_MAX) && (first > 0) &&
+			!vector_at(instruction, code, first)->label &&
+			(vector_at(instruction, code, first - 1)->op == OP_VALUE)
+		) {
+			first--;
+			spec.count++;
+		}
+		if (!spec.count) continue;
+		for (size_t j = 0; j < spec.count; j++) {
+			spec.args[j] = vector_at(instruction, code, first + j)->operand;
+		}
+
+		for (size_t j = 0; j < specs.size; j++) {
+			specialization* iter = vector_at(specialization, &specs, j);
+			if ((iter->begin != spec.begin) || (iter->count != spec.count)) continue;
+			if (memcmp(iter->args, spec.args, spec.count * sizeof(value))) continue;
+			keyword = iter->keyword;
+			break;
+		}
+
+		if (!keyword) {
+			size_t base = func->begin + 1;
+			size_t cost = 18;
+			bool local = true;
+			function_data clone_func;
+			instruction header;
+
+			vector_clear(instruction, &clone);
+			for (size_t j = first; j < i; j++) {
+				instruction inst = *vector_at(instruction, code, j);
+				inst.label = false;
+				if (!vector_push_back(instruction, &clone, inst)) goto FAILURE_VECTOR;
+			}
+			for (size_t j = base; j < func->end; j++) {
+				instruction inst = *vector_at(instruction, code, j);
+				if (instruction_is_branch(inst.op)) {
+					if ((inst.target < base) || (inst.target >= func->end)) {
+						local = false;
+						break;
+					}
+					inst.target = inst.target - base + spec.count;
+				}
+				if (!vector_push_back(instruction, &clone, inst)) goto FAILURE_VECTOR;
+			}
+			if (!local) continue;
+
+			if (!compiler_fold(&inter, &clone, &uses, func)) goto END;
+			if (clone.size >= spec.count + func->end - base) continue;
+
+			for (size_t j = 0; j < clone.size; j++) {
+				cost += instruction_size(vector_at(instruction, &clone, j));
+			}
+			if (cost > budget) continue;
+			budget -= cost;
+
+			keyword = ++comp->dictionary_keyword_count;
+			spec.keyword = keyword;
+			if (!vector_push_back(specialization, &specs, spec)) goto FAILURE_VECTOR;
+
+			header.op = OP_VALUE;
+			header.operand.u = keyword;
+			header.target = 0;
+			header.keyword = true;
+			header.label = false;
+			header.source = SIZE_MAX;
+			if (!vector_push_back(instruction, &clones, header)) goto FAILURE_VECTOR;
+
+			clone_func.keyword = keyword;
+			clone_func.ctrl = CTRL_FUNC;
+			clone_func.toplevel = true;
+			clone_func.installed = false;
+			clone_func.begin = clones.size;
+			clone_func.end = clones.size + 1 + clone.size;
+
+			header.op = OP_FUNC;
+			header.operand.u = 0;
+			header.target = clone_func.end;
+			header.keyword = false;
+			if (!vector_push_back(instruction, &clones, header)) goto FAILURE_VECTOR;
+
+			for (size_t j = 0; j < clone.size; j++) {
+				instruction inst = *vector_at(instruction, &clone, j);
+				if (instruction_is_branch(inst.op)) inst.target += clone_func.begin + 1;
+				if (!vector_push_back(instruction, &clones, inst)) goto FAILURE_VECTOR;
+			}
+			if (!vector_push_back(function_data, &clone_functions, clone_func)) goto FAILURE_VECTOR;
+		}
+
+		for (size_t j = first; j < i; j++) {
+			vector_at(instruction, code, j)->op = OP_NONE;
+		}
+		vector_at(instruction, code, i)->operand.u = keyword;
+	}
+
+	if (clones.size) {
+		size_t original_size = code->size;
+
+		if (!vector_resize(instruction, code, original_size + clones.size)) goto FAILURE_VECTOR;
+		memmove(code->p_data + clones.size, code->p_data, original_size * sizeof(instruction));
+		memcpy(code->p_data, clones.p_data, clones.size * sizeof(instruction));
+		for (size_t i = clones.size; i < code->size; i++) {
+			instruction* iter = vector_at(instruction, code, i);
+			if (instruction_is_branch(iter->op)) iter->target += clones.size;
+		}
+
+		for (size_t i = 0; i < comp->function_vector.size; i++) {
+			function_data* func = vector_at(function_data, &comp->function_vector, i);
+			func->begin += clones.size;
+			func->end += clones.size;
+			if (!vector_push_back(function_data, &clone_functions, *func)) goto FAILURE_VECTOR;
+		}
+		vector_free(function_data, &comp->function_vector);
+		comp->function_vector = clone_functions;
+		vector_init(function_data, &clone_functions);
+	}
+
+	compiler_mark_labels(code);
+	result = true;
+	goto END;
+
+FAILURE_VECTOR:
+	fputs("error : Specialization memory allocation failure\n", stderr);
+
+END:
+	vector_free(function_data, &sorted);
+	vector_free(function_data, &clone_functions);
+	vector_free(keyword_use, &uses);
+	vector_free(specialization, &specs);
+	vector_free(instruction, &clones);
+	vector_free(instruction, &clone);
+	interpreter_del(&inter);
+	return result;
+}
+
+bool compiler_prune(vector(instruction)* code, bool* changed) {
+	vector(size_t) worklist;
+	vector(size_t) switches;
+	bool* reached = (bool*) calloc(code->size + 1, sizeof(bool));
+	if (!reached) goto FAILURE_ALLOC;
+
+	vector_init(size_t, &worklist);
+	vector_init(size_t, &switches);
+	if (!vector_push_back(size_t, &worklist, 0)) goto FAILURE_VECTOR;
+
+	do {
+		while (worklist.size) {
+			size_t i = *vector_back(size_t, &worklist);
+			vector_pop_back(size_t, &worklist);
+			if ((i >= code->size) || reached[i]) continue;
+			reached[i] = true;
+
+			instruction* iter = vector_at(instruction, code, i);
+			switch (iter->op) {
+				case OP_RETURN:
+				case OP_ENDMACRO: {
+				} break;
+				case OP_JUMP: {
+					if (!vector_push_back(size_t, &worklist, iter->target)) goto FAILURE_VECTOR;
+				} break;
+				case OP_IF: {
+					if (!vector_push_back(size_t, &worklist, iter->target)) goto FAILURE_VECTOR;
+					if (!vector_push_back(size_t, &worklist, i + 1)) goto FAILURE_VECTOR;
+				} break;
+				default: {
+					if (!vector_push_back(size_t, &worklist, i + 1)) goto FAILURE_VECTOR;
+				}
+			}
+		}
+
+		vector_clear(size_t, &switches);
+		for (size_t i = 0; i < code->size; i++) {
+			instruction* iter = vector_at(instruction, code, i);
+			if (iter->op == OP_SWITCH) {
+				if (!vector_push_back(size_t, &switches, i)) goto FAILURE_VECTOR;
+			}
+			else if ((iter->op == OP_ENDSWITCH) && switches.size) {
+				if (reached[*vector_back(size_t, &switches)] && !reached[i]) {
+					if (!vector_push_back(size_t, &worklist, i)) goto FAILURE_VECTOR;
+				}
+				vector_pop_back(size_t, &switches);
+			}
+		}
+	} while (worklist.size);
+
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if (reached[i] || (iter->op == OP_NONE)) continue;
+		iter->op = OP_NONE;
+		*changed = true;
+	}
+
+	vector_free(size_t, &worklist);
+	vector_free(size_t, &switches);
+	free(reached);
+	return true;
+
+FAILURE_VECTOR:
+	vector_free(size_t, &worklist);
+	vector_free(size_t, &switches);
+	free(reached);
+FAILURE_ALLOC:
+	fputs("error : Reachability memory allocation failure\n", stderr);
+	return false;
+}
+
+bool compiler_fold(interpreter* inter, vector(instruction)* code, vector(keyword_use)* uses, function_data* func) {
+	bool changed = true;
+
+	for (int iteration = 0; changed && (iteration < FOLD_ITERATION_MAX); iteration++) {
+		changed = false;
+		if (!compiler_compact(code, NULL)) return false;
+		compiler_mark_labels(code);
+
+		size_t pending[FOLD_PENDING_MAX];
+		size_t pending_count = 0;
+
+		for (size_t i = 0; i + 1 < code->size; i++) {
+			instruction* iter = vector_at(instruction, code, i);
+			instruction* store = vector_at(instruction, code, i + 1);
+			instruction* bound;
+			bool read_outside;
+
+			if (iter->label || (iter->op != OP_VALUE)) break;
+			if (!(iter->keyword && (store->op == OP_TO) && !store->label)) {
+				if (pending_count == FOLD_PENDING_MAX) break;
+				pending[pending_count++] = i;
+				continue;
+			}
+			if (!pending_count) break;
+			bound = vector_at(instruction, code, pending[--pending_count]);
+			i++;
+			if (!compiler_local_keyword(uses, iter->operand.u, func, &read_outside)) continue;
+
+			for (size_t j = i + 1; j < code->size; j++) {
+				instruction* read = vector_at(instruction, code, j);
+				if ((read->op != OP_CALL) || (read->operand.u != iter->operand.u)) continue;
+				read->op = OP_VALUE;
+				read->operand = bound->operand;
+				read->keyword = bound->keyword;
+				changed = true;
+			}
+			if (!read_outside) {
+				bound->op = OP_NONE;
+				iter->op = OP_NONE;
+				store->op = OP_NONE;
+				changed = true;
+			}
+		}
+
+		for (size_t i = 0; i < code->size; i++) {
+			instruction* iter = vector_at(instruction, code, i);
+			int arity = instruction_fold_arity(iter->op);
+			value args[6];
+			value results[8];
+			size_t result_count;
+			bool foldable = true;
+
+			if ((iter->op == OP_JUMP) && (iter->target == i + 1)) {
+				iter->op = OP_NONE;
+				changed = true;
+				continue;
+			}
+
+			if ((iter->op == OP_IF) && (i > 0) && !iter->label) {
+				instruction* cond = vector_at(instruction, code, i - 1);
+				if ((cond->op != OP_VALUE) || cond->keyword) continue;
+				iter->op = cond->operand.u ? OP_NONE : OP_JUMP;
+				cond->op = OP_NONE;
+				changed = true;
+				continue;
+			}
+
+			if (!arity || (i < (size_t) arity)) continue;
+			for (int j = 0; j < arity; j++) {
+				instruction* arg = vector_at(instruction, code, i - arity + j);
+				if ((arg->op != OP_VALUE) || arg->keyword) foldable = false;
+				if (vector_at(instruction, code, i - j)->label) foldable = false;
+				args[j] = arg->operand;
+			}
+			if (!foldable) continue;
+
+			switch (iter->op) {
+				case OP_DIV:
+				case OP_MOD: {
+					if (!args[1].u) foldable = false;
+					if ((args[1].i == -1) && (args[0].i == INT64_MIN)) foldable = false;
+				} break;
+				case OP_UDIV:
+				case OP_UMOD: {
+					if (!args[1].u) foldable = false;
+				} break;
+				case OP_FDIV:
+				case OP_FMOD: {
+					if (args[1].f == 0) foldable = false;
+				} break;
+				case OP_LSFT:
+				case OP_RSFT: {
+					if (args[1].u >= 64) foldable = false;
+				} break;
+			}
+			if (!foldable) continue;
+
+			if (!compiler_fold_operation(inter, iter->op, args, arity, results, &result_count)) return false;
+			if (result_count > (size_t) arity + 1) continue;
+
+			for (size_t j = 0; j <= (size_t) arity; j++) {
+				instruction* out = vector_at(instruction, code, i - arity + j);
+				if (j < result_count) {
+					out->op = OP_VALUE;
+					out->operand = results[j];
+					out->keyword = false;
+				}
+				else out->op = OP_NONE;
+			}
+			changed = true;
+		}
+
+		if (!compiler_prune(code, &changed)) return false;
+	}
+
+	return compiler_compact(code, NULL);
+}
+
+bool compiler_fold_operation(interpreter* inter, uint8_t op, value* args, int arity, value* results, size_t* result_count) {
+	uint8_t code = op;
+
+	vector_clear(value, &inter->data_stack);
+	for (int i = 0; i < arity; i++) {
+		if (!interpreter_push(inter, args[i])) return false;
+	}
+
+	inter->bytecode = &code;
+	inter->bytecode_size = 1;
+	if (!interpreter_execute(inter, 0, 1)) return false;
+
+	*result_count = inter->data_stack.size;
+	for (size_t i = 0; i < *result_count; i++) {
+		results[i] = *vector_at(value, &inter->data_stack, i);
+	}
+	return true;
+}
+
+bool compiler_scratch_use(vector(instruction)* code, size_t index) {
+	instruction* next;
+
+	if (index + 1 >= code->size) return false;
+	next = vector_at(instruction, code, index + 1);
+	if (next->label) return false;
+
+	switch (next->op) {
+		case OP_FETCH:
+		case OP_STORE:
+		case OP_FREE: {
+			return true;
+		}
+		case OP_VALUE: {
+			if (next->keyword || (index + 3 >= code->size)) return false;
+			instruction* offset = vector_at(instruction, code, index + 2);
+			instruction* access = vector_at(instruction, code, index + 3);
+			if (offset->label || access->label) return false;
+			if ((offset->op != OP_ADD) && (offset->op != OP_SUB)) return false;
+			return (access->op == OP_FETCH) || (access->op == OP_STORE);
+		}
+	}
+	return false;
+}
+
+bool compiler_scratch_candidate(vector(instruction)* code, vector(keyword_use)* uses, function_data* func, size_t index) {
+	instruction* size = vector_at(instruction, code, index);
+	instruction* alloc = vector_at(instruction, code, index + 1);
+	instruction* name = vector_at(instruction, code, index + 2);
+	instruction* store = vector_at(instruction, code, index + 3);
+	bool read_outside;
+
+	if ((size->op != OP_VALUE) || size->keyword) return false;
+	if (!size->operand.u || (size->operand.u > SCRATCH_CELLS_MAX)) return false;
+	if ((alloc->op != OP_ALLOC) || alloc->label) return false;
+	if ((name->op != OP_VALUE) || !name->keyword || name->label) return false;
+	if ((store->op != OP_TO) || store->label) return false;
+
+	for (size_t i = index + 1; i < func->end; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if (!instruction_is_branch(iter->op)) continue;
+		if (iter->target <= index + 1) return false;
+	}
+
+	if (!compiler_local_keyword(uses, name->operand.u, func, &read_outside)) return false;
+	if (read_outside) return false;
+
+	for (size_t i = compiler_find_keyword_use(uses, name->operand.u); i < uses->size; i++) {
+		keyword_use* use = vector_at(keyword_use, uses, i);
+		if (use->keyword != name->operand.u) break;
+		if (use->op != OP_CALL) continue;
+		if (!compiler_scratch_use(code, use->index)) return false;
+	}
+	return true;
+}
+
+bool compiler_scratch_alloc(compiler* comp, vector(instruction)* code) {
+	vector(keyword_use) uses;
+	bool result = false;
+
+	vector_init(keyword_use, &uses);
+	if (!compiler_collect_keyword_uses(code, &uses)) goto END;
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		bool nested = false;
+
+		if (!(func->toplevel && func->end && (func->ctrl == CTRL_FUNC))) continue;
+		for (size_t j = func->begin + 1; j < func->end; j++) {
+			uint8_t op = vector_at(instruction, code, j)->op;
+			if ((op == OP_FUNC) || (op == OP_MACRO) || (op == OP_ALIAS)) nested = true;
+		}
+		if (nested) continue;
+
+		for (size_t j = func->begin + 1; j + 3 < func->end; j++) {
+			size_t keyword;
+			if (!compiler_scratch_candidate(code, &uses, func, j)) continue;
+
+			vector_at(instruction, code, j + 1)->op = OP_SALLOC;
+			keyword = vector_at(instruction, code, j + 2)->operand.u;
+			for (size_t k = compiler_find_keyword_use(&uses, keyword); k < uses.size; k++) {
+				keyword_use* use = vector_at(keyword_use, &uses, k);
+				if (use->keyword != keyword) break;
+				if (use->op != OP_CALL) continue;
+				if (vector_at(instruction, code, use->index + 1)->op != OP_FREE) continue;
+				vector_at(instruction, code, use->index)->op = OP_NONE;
+				vector_at(instruction, code, use->index + 1)->op = OP_NONE;
+			}
+		}
+	}
+
+	if (!compiler_compact(code, &comp->function_vector)) goto END;
+	compiler_mark_labels(code);
+	result = true;
+
+END:
+	vector_free(keyword_use, &uses);
+	return result;
+}
+
+bool compiler_mergeable_function(vector(instruction)* code, function_data* func) {
+	if (!(func->toplevel && func->end && (func->ctrl == CTRL_FUNC))) return false;
+	for (size_t i = func->begin + 1; i < func->end; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if ((iter->op == OP_FUNC) || (iter->op == OP_MACRO) || (iter->op == OP_ALIAS)) return false;
+		if (!instruction_is_branch(iter->op)) continue;
+		if ((iter->target <= func->begin) || (iter->target >= func->end)) return false;
+	}
+	return true;
+}
+
+uint64_t compiler_hash_function(vector(instruction)* code, function_data* func) {
+	uint64_t hash = FNV_OFFSET_BASIS;
+
+	for (size_t i = func->begin + 1; i < func->end; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		value operand = iter->operand;
+		if (instruction_is_branch(iter->op)) operand.u = iter->target - func->begin;
+		else if (!instruction_has_operand(iter->op)) operand.u = 0;
+
+		hash = (hash ^ iter->op) * FNV_PRIME;
+		hash = (hash ^ iter->keyword) * FNV_PRIME;
+		for (int j = 0; j < 8; j++) {
+			hash = (hash ^ operand.bytes[j]) * FNV_PRIME;
+		}
+	}
+	return hash;
+}
+
+bool compiler_equal_function(vector(instruction)* code, function_data* a, function_data* b) {
+	if (a->end - a->begin != b->end - b->begin) return false;
+	for (size_t i = 1; i < a->end - a->begin; i++) {
+		instruction* x = vector_at(instruction, code, a->begin + i);
+		instruction* y = vector_at(instruction, code, b->begin + i);
+		if ((x->op != y->op) || (x->keyword != y->keyword)) return false;
+		if (instruction_is_branch(x->op)) {
+			if (x->target - a->begin != y->target - b->begin) return false;
+		}
+		else if (instruction_has_operand(x->op)) {
+			if (x->operand.u != y->operand.u) return false;
+		}
+	}
+	return true;
+}
+
+int compiler_compare_function_hash(const void* a, const void* b) {
+	const function_hash* x = (const function_hash*) a;
+	const function_hash* y = (const function_hash*) b;
+	if (x->hash != y->hash) return (x->hash < y->hash) ? -1 : 1;
+	if (x->index != y->index) return (x->index < y->index) ? -1 : 1;
+	return 0;
+}
+
+bool compiler_merge_functions(compiler* comp, vector(instruction)* code) {
+	vector(function_hash) hashes;
+	bool* merged = (bool*) calloc(comp->function_vector.size + 1, sizeof(bool));
+	size_t kept = 0;
+
+	vector_init(function_hash, &hashes);
+	if (!merged) goto FAILURE_ALLOC;
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		function_hash entry;
+		if (!compiler_mergeable_function(code, func)) continue;
+		entry.hash = compiler_hash_function(code, func);
+		entry.index = i;
+		if (!vector_push_back(function_hash, &hashes, entry)) goto FAILURE_ALLOC;
+	}
+	if (hashes.size > 1) qsort(hashes.p_data, hashes.size, sizeof(function_hash), compiler_compare_function_hash);
+
+	for (size_t i = 0; i < hashes.size; i++) {
+		function_hash* origin = vector_at(function_hash, &hashes, i);
+		function_data* origin_func;
+		if (merged[origin->index]) continue;
+		origin_func = vector_at(function_data, &comp->function_vector, origin->index);
+
+		for (size_t j = i + 1; j < hashes.size; j++) {
+			function_hash* other = vector_at(function_hash, &hashes, j);
+			function_data* other_func;
+			instruction* alias;
+			if (other->hash != origin->hash) break;
+			if (merged[other->index]) continue;
+			other_func = vector_at(function_data, &comp->function_vector, other->index);
+			if (!compiler_equal_function(code, origin_func, other_func)) continue;
+
+			alias = vector_at(instruction, code, other_func->begin);
+			alias->op = OP_ALIAS;
+			alias->target = origin_func->begin + 1;
+			for (size_t k = other_func->begin + 1; k < other_func->end; k++) {
+				vector_at(instruction, code, k)->op = OP_NONE;
+			}
+			merged[other->index] = true;
+		}
+	}
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		if (merged[i]) continue;
+		*vector_at(function_data, &comp->function_vector, kept++) = *vector_at(function_data, &comp->function_vector, i);
+	}
+	if (!vector_resize(function_data, &comp->function_vector, kept)) goto FAILURE_ALLOC;
+
+	if (!compiler_compact(code, &comp->function_vector)) goto FAILURE;
+	compiler_mark_labels(code);
+
+	vector_free(function_hash, &hashes);
+	free(merged);
+	return true;
+
+FAILURE_ALLOC:
+	fputs("error : Function merging memory allocation failure\n", stderr);
+FAILURE:
+	vector_free(function_hash, &hashes);
+	free(merged);
+	return false;
+}
+
+size_t compiler_find_function_index(vector(function_data)* functions, size_t begin) {
+	size_t low = 0;
+	size_t high = functions->size;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		size_t func_begin = vector_at(function_data, functions, mid)->begin;
+		if (func_begin == begin) return mid;
+		if (func_begin < begin) low = mid + 1;
+		else high = mid;
+	}
+	return SIZE_MAX;
+}
+
+bool compiler_static_hotness(compiler* comp, vector(instruction)* code, double* hotness) {
+	vector(function_data) sorted;
+	vector(size_t) open;
+	size_t function_count = comp->function_vector.size;
+	size_t next_function = 0;
+	int* depth = (int*) calloc(code->size + 1, sizeof(int));
+	double* weight = (double*) calloc(function_count + 1, sizeof(double));
+	double* edges = NULL;
+	size_t* edge_caller = NULL;
+	size_t* edge_callee = NULL;
+	size_t edge_count = 0;
+
+	vector_init(function_data, &sorted);
+	vector_init(size_t, &open);
+
+	if (!(depth && weight)) goto FAILURE_ALLOC;
+	edges = (double*) malloc(code->size * sizeof(double));
+	edge_caller = (size_t*) malloc(code->size * sizeof(size_t));
+	edge_callee = (size_t*) malloc(code->size * sizeof(size_t));
+	if (code->size && !(edges && edge_caller && edge_callee)) goto FAILURE_ALLOC;
+
+	if (!compiler_sort_functions(code, &comp->function_vector, &sorted)) goto FAILURE;
+
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		if ((iter->op != OP_JUMP) && (iter->op != OP_IF)) continue;
+		if (iter->target > i) continue;
+		depth[iter->target]++;
+		depth[i + 1]--;
+	}
+	for (size_t i = 1; i <= code->size; i++) {
+		depth[i] += depth[i - 1];
+	}
+
+	for (size_t i = 0; i < code->size; i++) {
+		instruction* iter = vector_at(instruction, code, i);
+		function_data* callee;
+		double call_weight = 1;
+
+		while (open.size) {
+			function_data* top = vector_at(function_data, &comp->function_vector, *vector_back(size_t, &open));
+			if (top->end > i) break;
+			vector_pop_back(size_t, &open);
+		}
+		while (next_function < function_count) {
+			if (vector_at(function_data, &comp->function_vector, next_function)->begin >= i) break;
+			if (!vector_push_back(size_t, &open, next_function)) goto FAILURE_ALLOC;
+			next_function++;
+		}
+
+		if (iter->op != OP_CALL) continue;
+		callee = compiler_find_function(&sorted, iter->operand.u);
+		if (!callee) continue;
+
+		for (int j = 0; (j < depth[i]) && (j < LAYOUT_LOOP_DEPTH_MAX); j++) {
+			call_weight *= LAYOUT_LOOP_WEIGHT;
+		}
+		edge_caller[edge_count] = open.size ? *vector_back(size_t, &open) : function_count;
+		edge_callee[edge_count] = compiler_find_function_index(&comp->function_vector, callee->begin);
+		edges[edge_count] = call_weight;
+		edge_count++;
+	}
+
+	weight[function_count] = 1;
+	for (int pass = 0; pass < LAYOUT_PASS_MAX; pass++) {
+		for (size_t i = 0; i < function_count; i++) {
+			hotness[i] = 0;
+		}
+		for (size_t i = 0; i < edge_count; i++) {
+			if (edge_callee[i] == SIZE_MAX) continue;
+			hotness[edge_callee[i]] += weight[edge_caller[i]] * edges[i];
+		}
+		for (size_t i = 0; i < function_count; i++) {
+			weight[i] = (hotness[i] > LAYOUT_HOTNESS_MAX) ? LAYOUT_HOTNESS_MAX : hotness[i];
+		}
+	}
+	for (size_t i = 0; i < function_count; i++) {
+		hotness[i] = weight[i];
+	}
+
+	vector_free(function_data, &sorted);
+	vector_free(size_t, &open);
+	free(depth);
+	free(weight);
+	free(edges);
+	free(edge_caller);
+	free(edge_callee);
+	return true;
+
+FAILURE_ALLOC:
+	fputs("error : Call graph memory allocation failure\n", stderr);
+FAILURE:
+	vector_free(function_data, &sorted);
+	vector_free(size_t, &open);
+	free(depth);
+	free(weight);
+	free(edges);
+	free(edge_caller);
+	free(edge_callee);
+	return false;
+}
+
+bool compiler_profile_hotness(compiler* comp, double* hotness) {
+	FILE* file;
+	char name[LAYOUT_NAME_MAX];
+	double count;
+
+	file = fopen(comp->options.profile_filename, "r");
+	if (!file) {
+		fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", comp->options.profile_filename);
+		fputs("error : Profile reading failure\n", stderr);
+		return false;
+	}
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		hotness[i] = 0;
+	}
+
+	while (fscanf(file, "%1023s %lf", name, &count) == 2) {
+		dict_entry* word = dict_find(&comp->dictionary, name);
+		if (!word) continue;
+		if (word->type != WTT_KWRD) continue;
+		for (size_t i = 0; i < comp->function_vector.size; i++) {
+			function_data* func = vector_at(function_data, &comp->function_vector, i);
+			if (func->keyword == word->data.u) hotness[i] += count;
+		}
+	}
+
+	fclose(file);
+	return true;
+}
+
+bool compiler_layout(compiler* comp, vector(instruction)* code) {
+	vector(instruction) layout;
+	vector(size_t) hot;
+	vector(size_t) cold;
+	vector(keyword_use) uses;
+	size_t function_count = comp->function_vector.size;
+	size_t size = code->size;
+	double* hotness = (double*) calloc(function_count + 1, sizeof(double));
+	size_t* owner = (size_t*) malloc((size + 1) * sizeof(size_t));
+	size_t* position = (size_t*) malloc((size + 1) * sizeof(size_t));
+	size_t* successor = (size_t*) malloc((size + 1) * sizeof(size_t));
+	size_t hot_begin = 0;
+	size_t main_end;
+	double hotness_max = 0;
+	instruction jump;
+
+	vector_init(instruction, &layout);
+	vector_init(size_t, &hot);
+	vector_init(size_t, &cold);
+	vector_init(keyword_use, &uses);
+
+	if (!(hotness && owner && position && successor)) goto FAILURE_ALLOC;
+	if (!compiler_collect_keyword_uses(code, &uses)) goto FAILURE;
+
+	if (comp->options.layout == LAYOUT_PROFILE) {
+		if (!compiler_profile_hotness(comp, hotness)) goto FAILURE;
+	}
+	else {
+		if (!compiler_static_hotness(comp, code, hotness)) goto FAILURE;
+	}
+
+	for (size_t i = 0; i <= size; i++) {
+		owner[i] = SIZE_MAX;
+	}
+
+	for (size_t i = 0; i < function_count; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		instruction* name;
+		if (!(func->toplevel && func->end && func->begin)) continue;
+		name = vector_at(instruction, code, func->begin - 1);
+		if (!((name->op == OP_VALUE) && name->keyword && (name->operand.u == func->keyword))) continue;
+		if (owner[func->begin - 1] != SIZE_MAX) continue;
+		if (compiler_variable_keyword(code, &uses, func->keyword)) continue;
+		for (size_t j = func->begin - 1; j < func->end; j++) {
+			owner[j] = i;
+		}
+		if (hotness[i] > hotness_max) hotness_max = hotness[i];
+		if (!vector_push_back(size_t, &hot, i)) goto FAILURE_ALLOC;
+	}
+
+	for (size_t i = 0; i < hot.size; ) {
+		size_t index = *vector_at(size_t, &hot, i);
+		if ((hotness[index] > 0) && (hotness[index] * LAYOUT_COLD_RATIO >= hotness_max)) {
+			i++;
+			continue;
+		}
+		if (!vector_push_back(size_t, &cold, index)) goto FAILURE_ALLOC;
+		memmove(hot.p_data + i, hot.p_data + i + 1, (hot.size - i - 1) * sizeof(size_t));
+		vector_pop_back(size_t, &hot);
+	}
+
+	for (size_t i = 1; i < hot.size; i++) {
+		size_t index = *vector_at(size_t, &hot, i);
+		size_t j = i;
+		for (; (j > 0) && (hotness[*vector_at(size_t, &hot, j - 1)] < hotness[index]); j--) {
+			*vector_at(size_t, &hot, j) = *vector_at(size_t, &hot, j - 1);
+		}
+		*vector_at(size_t, &hot, j) = index;
+	}
+
+	jump.op = OP_JUMP;
+	jump.operand.u = 0;
+	jump.target = 0;
+	jump.keyword = false;
+	jump.label = false;
+	jump.source = SIZE_MAX;
+
+	if (cold.size) {
+		if (!vector_push_back(instruction, &layout, jump)) goto FAILURE_ALLOC;
+		hot_begin = layout.size;
+	}
+
+	for (size_t i = 0; i < hot.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, *vector_at(size_t, &hot, i));
+		for (size_t j = func->begin - 1; j < func->end; j++) {
+			position[j] = layout.size;
+			if (!vector_push_back(instruction, &layout, *vector_at(instruction, code, j))) goto FAILURE_ALLOC;
+		}
+	}
+	for (size_t i = 0; i < size; i++) {
+		if (owner[i] != SIZE_MAX) continue;
+		position[i] = layout.size;
+		if (!vector_push_back(instruction, &layout, *vector_at(instruction, code, i))) goto FAILURE_ALLOC;
+	}
+	main_end = layout.size;
+	if (cold.size) {
+		if (!vector_push_back(instruction, &layout, jump)) goto FAILURE_ALLOC;
+		vector_at(instruction, &layout, 0)->target = layout.size;
+		for (size_t i = 0; i < cold.size; i++) {
+			function_data* func = vector_at(function_data, &comp->function_vector, *vector_at(size_t, &cold, i));
+			for (size_t j = func->begin - 1; j < func->end; j++) {
+				position[j] = layout.size;
+				if (!vector_push_back(instruction, &layout, *vector_at(instruction, code, j))) goto FAILURE_ALLOC;
+			}
+		}
+		jump.target = hot_begin;
+		if (!vector_push_back(instruction, &layout, jump)) goto FAILURE_ALLOC;
+		vector_at(instruction, &layout, main_end)->target = layout.size;
+	}
+	position[size] = layout.size;
+
+	successor[size] = main_end;
+	for (size_t i = size; i-- > 0; ) {
+		successor[i] = (owner[i] == SIZE_MAX) ? position[i] : successor[i + 1];
+	}
+
+	for (size_t i = 0; i < size; i++) {
+		instruction* iter = vector_at(instruction, &layout, position[i]);
+		if (!instruction_is_branch(iter->op)) continue;
+		if (iter->op == OP_ALIAS) {
+			iter->target = position[iter->target];
+			continue;
+		}
+		if (owner[i] == SIZE_MAX) {
+			iter->target = successor[iter->target];
+			continue;
+		}
+		function_data* func = vector_at(function_data, &comp->function_vector, owner[i]);
+		if (i == func->begin) iter->target = position[func->end - 1] + 1;
+		else if ((iter->target >= func->begin - 1) && (iter->target < func->end)) iter->target = position[iter->target];
+		else iter->target = successor[iter->target];
+	}
+
+	for (size_t i = 0; i < function_count; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		if (owner[func->begin] == i) {
+			func->end = position[func->end - 1] + 1;
+			func->begin = position[func->begin];
+		}
+		else if (owner[func->begin] != SIZE_MAX) {
+			func->begin = position[func->begin];
+			func->end = position[func->end];
+		}
+		else {
+			func->begin = position[func->begin];
+			func->end = successor[func->end];
+		}
+	}
+
+	vector_free(instruction, code);
+	*code = layout;
+	compiler_mark_labels(code);
+
+	vector_free(size_t, &hot);
+	vector_free(size_t, &cold);
+	vector_free(keyword_use, &uses);
+	free(hotness);
+	free(owner);
+	free(position);
+	free(successor);
+	return true;
+
+FAILURE_ALLOC:
+	fputs("error : Layout memory allocation failure\n", stderr);
+FAILURE:
+	vector_free(instruction, &layout);
+	vector_free(size_t, &hot);
+	vector_free(size_t, &cold);
+	vector_free(keyword_use, &uses);
+	free(hotness);
+	free(owner);
+	free(position);
+	free(successor);
+	return false;
+}
+
+
+bool compiler_install_functions(compiler* comp, vector(instruction)* code) {
+	vector(function_data) sorted;
+	vector(keyword_use) uses;
+
+	vector_init(function_data, &sorted);
+	vector_init(keyword_use, &uses);
+	if (!compiler_sort_functions(code, &comp->function_vector, &sorted)) goto FAILURE;
+	if (!compiler_collect_keyword_uses(code, &uses)) goto FAILURE;
+
+	for (size_t i = 0; i < comp->function_vector.size; i++) {
+		function_data* func = vector_at(function_data, &comp->function_vector, i);
+		instruction* name;
+		instruction* head;
+		if (!(func->toplevel && func->end && func->begin)) continue;
+		if (!compiler_find_function(&sorted, func->keyword)) continue;
+		name = vector_at(instruction, code, func->begin - 1);
+		head = vector_at(instruction, code, func->begin);
+		if (!((name->op == OP_VALUE) && name->keyword && (name->operand.u == func->keyword))) continue;
+		if (!((head->op == OP_FUNC) || (head->op == OP_MACRO))) continue;
+		if (compiler_variable_keyword(code, &uses, func->keyword)) continue;
+
+		name->op = OP_NONE;
+		name->keyword = false;
+		head->op = OP_JUMP;
+		func->installed = true;
+	}
+
+	vector_free(function_data, &sorted);
+	vector_free(keyword_use, &uses);
+	return true;
+
+FAILURE:
+	vector_free(function_data, &sorted);
+	vector_free(keyword_use, &uses);
+	return false;
+}
\ No newline at end of file
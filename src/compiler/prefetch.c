@@ -0,0 +1,207 @@
+#include "compiler.h"
+
+bool compiler_prefetch(compiler* comp, char* input_filename) {
+	char filename_full[PATH_MAX];
+	prefetch_pool pool;
+	size_t count = comp->options.jobs - 1;
+	size_t started = 0;
+	pthread_t* threads;
+	bool result = true;
+
+#ifdef _WIN32
+	if (!(_fullpath(filename_full, input_filename, PATH_MAX))) return true;
+#else
+	if (!(realpath(input_filename, filename_full))) return true;
+#endif
+
+	if (!compiler_add_source(comp, filename_full)) return false;
+
+	threads = (pthread_t*) malloc(count * sizeof(pthread_t));
+	if (!threads) return false;
+
+	pthread_mutex_init(&pool.lock, NULL);
+	pthread_cond_init(&pool.wake, NULL);
+	pthread_cond_init(&pool.done, NULL);
+	pool.sources = &comp->sources;
+	pool.next = 0;
+	pool.end = comp->sources.size;
+	pool.failures = 0;
+	pool.stop = false;
+
+	for (; started < count; started++) {
+		if (pthread_create(&threads[started], NULL, compiler_prefetch_worker, &pool)) break;
+	}
+
+	for (size_t i = 0; result && (i < comp->sources.size); i++) {
+		source_file* source = *vector_at(cctl_ptr(source_file), &comp->sources, i);
+
+		pthread_mutex_lock(&pool.lock);
+		compiler_prefetch_wait(&pool, source);
+		result = compiler_prefetch_imports(comp, source);
+		pool.end = comp->sources.size;
+		pthread_cond_broadcast(&pool.wake);
+		pthread_mutex_unlock(&pool.lock);
+	}
+
+	pthread_mutex_lock(&pool.lock);
+	pool.stop = true;
+	pthread_cond_broadcast(&pool.wake);
+	pthread_mutex_unlock(&pool.lock);
+	for (size_t i = 0; i < started; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+
+	pthread_cond_destroy(&pool.done);
+	pthread_cond_destroy(&pool.wake);
+	pthread_mutex_destroy(&pool.lock);
+
+	if (pool.failures) {
+		fprintf(stderr, "warning : %zu source file(s) could not be prefetched and are read while compiling\n", pool.failures);
+	}
+	return result;
+}
+
+void compiler_prefetch_wait(prefetch_pool* pool, source_file* source) {
+	while (!source->prefetched) {
+		if (pool->next < pool->end) compiler_prefetch_claim(pool);
+		else pthread_cond_wait(&pool->done, &pool->lock);
+	}
+}
+
+void compiler_prefetch_claim(prefetch_pool* pool) {
+	source_file* source = *vector_at(cctl_ptr(source_file), pool->sources, pool->next++);
+	bool result;
+
+	pthread_mutex_unlock(&pool->lock);
+	result = compiler_prefetch_source(source);
+	pthread_mutex_lock(&pool->lock);
+
+	if (!result) pool->failures++;
+	source->prefetched = true;
+	pthread_cond_broadcast(&pool->done);
+}
+
+void* compiler_prefetch_worker(void* argument) {
+	prefetch_pool* pool = (prefetch_pool*) argument;
+
+	pthread_mutex_lock(&pool->lock);
+	while (!pool->stop) {
+		if (pool->next < pool->end) compiler_prefetch_claim(pool);
+		else pthread_cond_wait(&pool->wake, &pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+bool compiler_prefetch_source(source_file* source) {
+	if (compiler_object_file(source->filename)) return true;
+
+	source->textcode = compiler_read_source(source->filename);
+	if (!source->textcode) return false;
+
+	if (!compiler_scan_tokens(source->textcode, &source->tokens)) {
+		vector_free(token, &source->tokens);
+		return false;
+	}
+	source->ready = true;
+	return true;
+}
+
+bool compiler_prefetch_imports(compiler* comp, source_file* source) {
+	token* preproc = NULL;
+	char name[PATH_MAX];
+	char filename[PATH_MAX];
+	char filename_full[PATH_MAX];
+
+	if (!source->ready) return true;
+
+	for (size_t i = 0; i < source->tokens.size; i++) {
+		token* tok = vector_at(token, &source->tokens, i);
+		size_t length = tok->end - tok->begin;
+
+		if (*tok->begin == '#') {
+			preproc = tok;
+			continue;
+		}
+		if (!preproc || (length != 6) || memcmp(tok->begin, "import", 6)) continue;
+
+		length = preproc->end - preproc->begin - 1;
+		if (length + strlen(source->filename) + 2 > PATH_MAX) continue;
+		memcpy(name, preproc->begin + 1, length);
+		name[length] = 0;
+		compiler_join_filename(source->filename, name, filename);
+
+#ifdef _WIN32
+		if (!(_fullpath(filename_full, filename, PATH_MAX))) continue;
+#else
+		if (!(realpath(filename, filename_full))) continue;
+#endif
+		if (!compiler_add_source(comp, filename_full)) return false;
+	}
+	return true;
+}
+
+bool compiler_add_source(compiler* comp, char* filename) {
+	size_t filename_size = strlen(filename) + 1;
+	source_file* source;
+	dict_entry* entry;
+
+	if (dict_find(&comp->source_dict, filename)) return true;
+
+	source = (source_file*) malloc(sizeof(source_file));
+	if (!source) return false;
+	source->filename = (char*) malloc(filename_size);
+	if (!source->filename) {
+		free(source);
+		return false;
+	}
+	memcpy(source->filename, filename, filename_size);
+	source->textcode = NULL;
+	vector_init(token, &source->tokens);
+	source->ready = false;
+	source->prefetched = false;
+
+	entry = dict_insert(&comp->source_dict, filename, (uint8_t) true);
+	if (!(entry && vector_push_back(cctl_ptr(source_file), &comp->sources, source))) {
+		free(source->filename);
+		free(source);
+		return false;
+	}
+	entry->data.u = comp->sources.size - 1;
+	return true;
+}
+
+source_file* compiler_find_source(compiler* comp, char* filename) {
+	dict_entry* entry = dict_find(&comp->source_dict, filename);
+	if (!entry) return NULL;
+	return *vector_at(cctl_ptr(source_file), &comp->sources, entry->data.u);
+}
+
+char* compiler_read_source(char* filename) {
+	FILE* file = fopen(filename, "rb");
+	char* textcode;
+	size_t size;
+
+	if (!file) return NULL;
+
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	rewind(file);
+
+	textcode = (char*) malloc(size + 2);
+	if (!textcode) {
+		fclose(file);
+		return NULL;
+	}
+	if (size && (fread(textcode, size, 1, file) != 1)) {
+		free(textcode);
+		fclose(file);
+		return NULL;
+	}
+	fclose(file);
+
+	textcode[size] = '\n';
+	textcode[size + 1] = '\0';
+	return textcode;
+}
\ No newline at end of file
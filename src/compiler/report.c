@@ -0,0 +1,271 @@
+#include "compiler.h"
+
+const char* report_phase_names[] = {
+	"other",
+	"prefetch",
+	"load",
+	"tokenize",
+	"parse",
+	"control",
+	"optimize",
+	"save"
+};
+
+size_t report_phase_len = sizeof(report_phase_names) / sizeof(char*);
+
+bool compiler_report_init(compiler* comp) {
+	report_frame frame = {REPORT_OTHER, SIZE_MAX, true};
+
+	comp->report = (report*) malloc(sizeof(report));
+	if (!comp->report) goto FAILURE_MALLOC;
+
+	vector_init(report_frame, &comp->report->frames);
+	vector_init(report_entry, &comp->report->phases);
+	vector_init(report_entry, &comp->report->files);
+	comp->report->transient = 0;
+
+	if (!(
+		vector_resize(report_entry, &comp->report->phases, report_phase_len) &&
+		vector_push_back(report_frame, &comp->report->frames, frame)
+	)) goto FAILURE_MALLOC;
+
+	comp->report->clock = compiler_report_clock();
+	comp->report->footprint = compiler_report_footprint(comp);
+	return true;
+
+FAILURE_MALLOC:
+	compiler_report_del(comp);
+	fputs("error : Time report memory allocation failure\n", stderr);
+	return false;
+}
+
+void compiler_report_del(compiler* comp) {
+	if (!comp->report) return;
+	vector_free(report_frame, &comp->report->frames);
+	vector_free(report_entry, &comp->report->phases);
+	vector_free(report_entry, &comp->report->files);
+	free(comp->report);
+	comp->report = NULL;
+}
+
+double compiler_report_clock(void) {
+	struct timespec now;
+	timespec_get(&now, TIME_UTC);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+size_t compiler_report_footprint(compiler* comp) {
+	size_t result = comp->report->transient;
+
+	result += comp->textcode_vector.capacity * sizeof(cctl_ptr(char));
+	result += comp->textcode_size_vector.capacity * sizeof(size_t);
+	result += comp->filename_vector.capacity * sizeof(cctl_ptr(char));
+	result += comp->preproc_tokens_vector.capacity * sizeof(cctl_ptr(char));
+	result += comp->dependency_vector.capacity * sizeof(cctl_ptr(char));
+	result += comp->textcode_index_stack.capacity * sizeof(size_t);
+	result += comp->bytecode.capacity;
+	result += comp->control_entries.capacity * sizeof(control_data);
+	result += comp->control_frames.capacity * sizeof(size_t);
+	result += comp->control_pending.capacity * sizeof(control_data);
+	result += comp->switch_cases.capacity * sizeof(control_data);
+	result += comp->switch_passes.capacity * sizeof(control_data);
+	result += comp->switch_chains.capacity * sizeof(control_data);
+	result += comp->function_vector.capacity * sizeof(function_data);
+	result += comp->keyword_sites.capacity * sizeof(size_t);
+	result += comp->relocations.capacity * sizeof(relocation);
+	result += comp->constants.capacity;
+	result += comp->line_rows.capacity * sizeof(line_row);
+	result += comp->sources.capacity * sizeof(cctl_ptr(source_file));
+	result += comp->dictionary.capacity * sizeof(dict_entry*) + comp->dictionary.size * sizeof(dict_entry);
+	result += comp->filename_dict.capacity * sizeof(dict_entry*) + comp->filename_dict.size * sizeof(dict_entry);
+	result += comp->source_dict.capacity * sizeof(dict_entry*) + comp->source_dict.size * sizeof(dict_entry);
+	for (arena_block* block = comp->arena.block; block; block = block->previous) {
+		result += sizeof(arena_block) + block->size;
+	}
+
+	return result;
+}
+
+void compiler_report_account(compiler* comp, bool measure) {
+	report* r = comp->report;
+	report_frame* frame = vector_back(report_frame, &r->frames);
+	report_entry* entries[2];
+	double clock = compiler_report_clock();
+	size_t footprint = measure ? compiler_report_footprint(comp) : r->footprint;
+	size_t bytes = footprint > r->footprint ? footprint - r->footprint : 0;
+
+	entries[0] = vector_at(report_entry, &r->phases, frame->phase);
+	entries[1] = frame->file == SIZE_MAX ? NULL : vector_at(report_entry, &r->files, frame->file * report_phase_len + frame->phase);
+	for (size_t i = 0; i < 2; i++) {
+		if (!entries[i]) continue;
+		entries[i]->time += clock - r->clock;
+		entries[i]->bytes += bytes;
+	}
+
+	r->clock = clock;
+	r->footprint = footprint;
+}
+
+bool compiler_report_enter(compiler* comp, report_phase phase, size_t file) {
+	report* r = comp->report;
+	report_frame frame = {phase, file, phase != REPORT_CONTROL};
+
+	compiler_report_account(comp, frame.measure);
+	if (file != SIZE_MAX) {
+		if (r->files.size < (file + 1) * report_phase_len) {
+			if (!vector_resize(report_entry, &r->files, (file + 1) * report_phase_len)) goto FAILURE_MALLOC;
+		}
+		vector_at(report_entry, &r->files, file * report_phase_len + phase)->calls++;
+	}
+	if (!vector_push_back(report_frame, &r->frames, frame)) goto FAILURE_MALLOC;
+	vector_at(report_entry, &r->phases, phase)->calls++;
+	return true;
+
+FAILURE_MALLOC:
+	fputs("error : Time report memory allocation failure\n", stderr);
+	return false;
+}
+
+void compiler_report_leave(compiler* comp) {
+	compiler_report_account(comp, vector_back(report_frame, &comp->report->frames)->measure);
+	vector_pop_back(report_frame, &comp->report->frames);
+}
+
+void compiler_report_scanned(compiler* comp, size_t bytes) {
+	report_frame* frame;
+
+	comp->report->transient += bytes;
+	compiler_report_account(comp, true);
+	frame = vector_back(report_frame, &comp->report->frames);
+	if (frame->phase == REPORT_TOKENIZE) frame->phase = REPORT_PARSE;
+}
+
+size_t compiler_report_load_code(compiler* comp, char* filename) {
+	size_t result;
+
+	if (!compiler_report_enter(comp, REPORT_LOAD, comp->filename_vector.size)) return 0;
+	result = compiler_load_code(comp, filename);
+	if (result) comp->report->transient += strlen(*vector_at(cctl_ptr(char), &comp->textcode_vector, result - 1)) + 1;
+	compiler_report_leave(comp);
+	return result;
+}
+
+bool compiler_report_tokenize(compiler* comp) {
+	bool result;
+
+	if (!compiler_report_enter(comp, REPORT_TOKENIZE, *vector_back(size_t, &comp->textcode_index_stack))) return false;
+	result = compiler_tokenize(comp);
+	compiler_report_leave(comp);
+	return result;
+}
+
+bool compiler_report_parse(compiler* comp, char* begin, char* end) {
+	report* r = comp->report;
+	report_frame* frame = vector_back(report_frame, &r->frames);
+
+	vector_at(report_entry, &r->phases, REPORT_PARSE)->calls++;
+	vector_at(report_entry, &r->files, frame->file * report_phase_len + REPORT_PARSE)->calls++;
+	return compiler_parse(comp, begin, end);
+}
+
+bool compiler_report_control_words(compiler* comp, dict_entry* dict_result) {
+	bool result;
+
+	if (!compiler_report_enter(comp, REPORT_CONTROL, *vector_back(size_t, &comp->textcode_index_stack))) return false;
+	result = compiler_parse_control_words(comp, dict_result);
+	compiler_report_leave(comp);
+	return result;
+}
+
+void compiler_report_sum(compiler* comp, size_t file, report_entry* sum) {
+	report_entry* entries = file == SIZE_MAX ? comp->report->phases.p_data : comp->report->files.p_data + file * report_phase_len;
+
+	sum->time = 0;
+	sum->calls = 0;
+	sum->bytes = 0;
+	for (size_t i = 0; i < report_phase_len; i++) {
+		sum->time += entries[i].time;
+		sum->bytes += entries[i].bytes;
+	}
+	if (file != SIZE_MAX) sum->calls = entries[REPORT_PARSE].calls;
+}
+
+bool compiler_report_print(compiler* comp) {
+	report* r = comp->report;
+	report_entry sum;
+	size_t files = r->files.size / report_phase_len;
+
+	printf("%-12s %12s %12s %14s\n", "phase", "calls", "time (s)", "bytes");
+	for (size_t i = 0; i < report_phase_len; i++) {
+		report_entry* entry = vector_at(report_entry, &r->phases, i);
+		printf("%-12s %12zu %12.6f %14zu\n", report_phase_names[i], entry->calls, entry->time, entry->bytes);
+	}
+	compiler_report_sum(comp, SIZE_MAX, &sum);
+	printf("%-12s %12s %12.6f %14zu\n", "total", "", sum.time, sum.bytes);
+
+	printf("\n%12s %12s %14s  %s\n", "tokens", "time (s)", "bytes", "file");
+	for (size_t i = 0; i < files; i++) {
+		if (!vector_at(report_entry, &r->files, i * report_phase_len + REPORT_LOAD)->calls) continue;
+		compiler_report_sum(comp, i, &sum);
+		printf("%12zu %12.6f %14zu  %s\n", sum.calls, sum.time, sum.bytes, *vector_at(cctl_ptr(char), &comp->filename_vector, i));
+	}
+
+	return true;
+}
+
+void compiler_report_json_entry(FILE* file, const char* name, report_entry* entry) {
+	fputs("{\"name\": \"", file);
+	for (const char* c = name; *c; c++) {
+		if ((*c == '"') || (*c == '\\')) fputc('\\', file);
+		if ((unsigned char) *c < 0x20) fprintf(file, "\\u%04x", *c);
+		else fputc(*c, file);
+	}
+	fprintf(file, "\", \"calls\": %zu, \"time\": %.9f, \"bytes\": %zu", entry->calls, entry->time, entry->bytes);
+}
+
+bool compiler_report_save(compiler* comp, char* filename) {
+	report* r = comp->report;
+	report_entry sum;
+	size_t files = r->files.size / report_phase_len;
+	bool first = true;
+
+	FILE* file = fopen(filename, "w");
+	if (!file) return false;
+
+	compiler_report_sum(comp, SIZE_MAX, &sum);
+	fprintf(file, "{\n\t\"time\": %.9f,\n\t\"bytes\": %zu,\n\t\"phases\": [", sum.time, sum.bytes);
+	for (size_t i = 0; i < report_phase_len; i++) {
+		fputs(i ? ",\n\t\t" : "\n\t\t", file);
+		compiler_report_json_entry(file, report_phase_names[i], vector_at(report_entry, &r->phases, i));
+		fputc('}', file);
+	}
+	fputs("\n\t],\n\t\"files\": [", file);
+	for (size_t i = 0; i < files; i++) {
+		if (!vector_at(report_entry, &r->files, i * report_phase_len + REPORT_LOAD)->calls) continue;
+		compiler_report_sum(comp, i, &sum);
+		fputs(first ? "\n\t\t" : ",\n\t\t", file);
+		first = false;
+		compiler_report_json_entry(file, *vector_at(cctl_ptr(char), &comp->filename_vector, i), &sum);
+		fputs(", \"phases\": [", file);
+		for (size_t j = 0; j < report_phase_len; j++) {
+			if (j) fputs(", ", file);
+			compiler_report_json_entry(file, report_phase_names[j], vector_at(report_entry, &r->files, i * report_phase_len + j));
+			fputc('}', file);
+		}
+		fputs("]}", file);
+	}
+	fputs("\n\t]\n}\n", file);
+
+	return !fclose(file);
+}
+
+bool compiler_report_output(compiler* comp) {
+	compiler_report_account(comp, true);
+	if (!comp->options.time_report_filename) return compiler_report_print(comp);
+	if (!compiler_report_save(comp, comp->options.time_report_filename)) {
+		fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", comp->options.time_report_filename);
+		fputs("error : Time report saving failure\n", stderr);
+		return false;
+	}
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "scanner.h"
+
+bool scanner_special(char c) {
+	switch (c) {
+		case '\0':
+		case '\t':
+		case '\n':
+		case '\r':
+		case ' ':
+		case '\"':
+		case '\'':
+		case '(':
+		case ')':
+		case '\\': {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool scanner_lead(char c) {
+	return ((signed char) c) >= -64;
+}
+
+#if defined(SCANNER_AVX2)
+__attribute__((target("avx2"))) __m256i scanner_special_avx2(__m256i bytes) {
+	__m256i mask = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r')));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\"')));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\'')));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('(')));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(')')));
+	mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\')));
+	return mask;
+}
+
+__attribute__((target("avx2"))) char* scanner_skip_avx2(char* iterator, char* limit, size_t* count) {
+	while (limit - iterator >= 32) {
+		__m256i bytes = _mm256_loadu_si256((const __m256i*) iterator);
+		uint32_t special = _mm256_movemask_epi8(scanner_special_avx2(bytes));
+		uint32_t lead = _mm256_movemask_epi8(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(-65)));
+		if (special) {
+			size_t length = __builtin_ctz(special);
+			*count += __builtin_popcount(lead & (((uint32_t) 1 << length) - 1));
+			return iterator + length;
+		}
+		*count += __builtin_popcount(lead);
+		iterator += 32;
+	}
+	return iterator;
+}
+#endif
+
+#if defined(__SSE2__)
+__m128i scanner_special_sse2(__m128i bytes) {
+	__m128i mask = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\"')));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\'')));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('(')));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(')')));
+	mask = _mm_or_si128(mask, _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\')));
+	return mask;
+}
+#endif
+
+char* scanner_skip(char* iterator, char* limit, size_t* columns) {
+	char* start = iterator;
+	size_t count = 0;
+
+#if defined(__SSE2__)
+	while (limit - iterator >= 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i*) iterator);
+		uint32_t special = _mm_movemask_epi8(scanner_special_sse2(bytes));
+		uint32_t lead = _mm_movemask_epi8(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(-65)));
+		if (special) {
+			size_t length = __builtin_ctz(special);
+			count += __builtin_popcount(lead & (((uint32_t) 1 << length) - 1));
+			iterator += length;
+			goto FOUND;
+		}
+		count += __builtin_popcount(lead);
+		iterator += 16;
+#if defined(SCANNER_AVX2)
+		if ((limit - iterator >= 32) && __builtin_cpu_supports("avx2")) {
+			iterator = scanner_skip_avx2(iterator, limit, &count);
+			if ((iterator < limit) && scanner_special(*iterator)) goto FOUND;
+		}
+#endif
+	}
+#endif
+	while ((iterator < limit) && !scanner_special(*iterator)) {
+		count += scanner_lead(*iterator);
+		iterator++;
+	}
+
+FOUND:
+	*columns += count + scanner_lead(*iterator) - scanner_lead(*start);
+	return iterator;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "dict.h"
+
+void dict_init(dict* d) {
+	d->entries = NULL;
+	d->capacity = 0;
+	d->size = 0;
+}
+
+void dict_del(dict* d) {
+	for (size_t i = 0; i < d->capacity; i++) {
+		free(d->entries[i]);
+	}
+	free(d->entries);
+	dict_init(d);
+}
+
+uint64_t dict_hash(const char* key, size_t* length) {
+	uint64_t hash = 0xcbf29ce484222325;
+	const char* iterator = key;
+	while (*iterator) {
+		hash ^= (uint8_t) *iterator;
+		hash *= 0x100000001b3;
+		iterator++;
+	}
+	*length = iterator - key;
+	return hash;
+}
+
+dict_entry** dict_slot(dict* d, const char* key, uint64_t hash) {
+	size_t mask = d->capacity - 1;
+	size_t index = hash & mask;
+	while (d->entries[index]) {
+		if ((d->entries[index]->hash == hash) && !strcmp(d->entries[index]->key, key)) break;
+		index = (index + 1) & mask;
+	}
+	return &d->entries[index];
+}
+
+bool dict_grow(dict* d) {
+	size_t capacity = d->capacity ? d->capacity * 2 : 64;
+	dict_entry** entries = (dict_entry**) calloc(capacity, sizeof(dict_entry*));
+	if (!entries) return false;
+
+	for (size_t i = 0; i < d->capacity; i++) {
+		dict_entry* entry = d->entries[i];
+		if (!entry) continue;
+		size_t index = entry->hash & (capacity - 1);
+		while (entries[index]) index = (index + 1) & (capacity - 1);
+		entries[index] = entry;
+	}
+	free(d->entries);
+	d->entries = entries;
+	d->capacity = capacity;
+	return true;
+}
+
+dict_entry* dict_insert(dict* d, const char* key, uint8_t type) {
+	size_t length;
+	uint64_t hash = dict_hash(key, &length);
+	dict_entry** slot;
+
+	if ((d->size + 1) * 4 > d->capacity * 3) {
+		if (!dict_grow(d)) return NULL;
+	}
+	slot = dict_slot(d, key, hash);
+	if (!(*slot)) {
+		*slot = (dict_entry*) malloc(sizeof(dict_entry) + length + 1);
+		if (!(*slot)) return NULL;
+		memcpy((*slot)->key, key, length + 1);
+		(*slot)->hash = hash;
+		(*slot)->data.u = 0;
+		d->size++;
+	}
+	(*slot)->type = type;
+	return *slot;
+}
+
+dict_entry* dict_find(dict* d, const char* key) {
+	size_t length;
+	dict_entry** slot;
+
+	if (!d->capacity) return NULL;
+	slot = dict_slot(d, key, dict_hash(key, &length));
+	if (!(*slot)) return NULL;
+	if (!(*slot)->type) return NULL;
+	return *slot;
+}
\ No newline at end of file
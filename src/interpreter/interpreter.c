@@ -10,11 +10,23 @@ bool interpreter_init(interpreter* inter) {
 	fflush(stdin);
 #endif
 
-	deque_init(value, &inter->data_stack);
+	inter->bytecode = NULL;
+	inter->bytecode_size = 0;
+	inter->constants = NULL;
+	inter->constants_size = 0;
+	inter->image_data = NULL;
+	inter->image_size = 0;
+	inter->image_mapped = false;
+	bytecode_init(&inter->image);
+
+	vector_init(value, &inter->data_stack);
 	deque_init(value, &inter->switch_stack);
 	deque_init(size_t, &inter->call_stack);
 
 	deque_init(cctl_ptr(rbt), &inter->local_words_stack);
+	scratch_init(&inter->scratch_region);
+	vector_init(allocation, &inter->allocations);
+	inter->track_allocations = false;
 	inter->global_words = rbt_new();
 	if (!(inter->global_words)) {
 		fputs("error : Dictionary memory allocation failure\n", stderr);
@@ -24,7 +36,7 @@ bool interpreter_init(interpreter* inter) {
 }
 
 void interpreter_del(interpreter* inter) {
-	deque_free(value, &inter->data_stack);
+	vector_free(value, &inter->data_stack);
 	deque_free(value, &inter->switch_stack);
 	deque_free(size_t, &inter->call_stack);
 	
@@ -32,10 +44,19 @@ void interpreter_del(interpreter* inter) {
 		rbt_free(*deque_at(cctl_ptr(rbt), &inter->local_words_stack, i));
 	}
 	deque_free(cctl_ptr(rbt), &inter->local_words_stack);
+	scratch_del(&inter->scratch_region);
+	vector_free(allocation, &inter->allocations);
 	rbt_free(inter->global_words);
+	bytecode_free(&inter->image);
+#ifndef _WIN32
+	if (inter->image_mapped) munmap(inter->image_data, inter->image_size);
+	else free(inter->image_data);
+#else
+	free(inter->image_data);
+#endif
 }
 
-bool interpreter_load_code(interpreter* inter, char* filename) {
+bool interpreter_read_code(interpreter* inter, char* filename) {
 	FILE* file;
 	size_t size;
 
@@ -64,56 +85,226 @@ bool interpreter_load_code(interpreter* inter, char* filename) {
 		return false;
 	}
 
-	inter->bytecode = code;
-	inter->bytecode_size = size;
-
 	fclose(file);
+
+	inter->image_data = code;
+	inter->image_size = size;
+	inter->image_mapped = false;
+	return true;
+}
+
+bool interpreter_map_code(interpreter* inter, char* filename) {
+#ifdef _WIN32
+	return interpreter_read_code(inter, filename);
+#else
+	struct stat status;
+	void* code;
+	int file;
+
+	file = open(filename, O_RDONLY);
+	if (file < 0) {
+		fputs("error : File reading failure\n", stderr);
+		return false;
+	}
+
+	if (fstat(file, &status) || (status.st_size <= 0)) {
+		close(file);
+		return interpreter_read_code(inter, filename);
+	}
+
+	code = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (code == MAP_FAILED) return interpreter_read_code(inter, filename);
+
+	inter->image_data = (uint8_t*) code;
+	inter->image_size = status.st_size;
+	inter->image_mapped = true;
 	return true;
+#endif
+}
+
+bool interpreter_load_code(interpreter* inter, char* filename) {
+	if (!interpreter_map_code(inter, filename)) return false;
+
+	if (!bytecode_parse(&inter->image, inter->image_data, inter->image_size)) {
+		fputs("error : Invalid bytecode file\n", stderr);
+		return false;
+	}
+	if (inter->image.flags & BYTECODE_FLAG_OBJECT) {
+		fputs("error : Object files must be linked before running\n", stderr);
+		return false;
+	}
+	if (!bytecode_decompress(&inter->image)) {
+		fputs("error : Bytecode decompression failure\n", stderr);
+		return false;
+	}
+
+	bytecode_section* section = bytecode_find_section(&inter->image, SECTION_CODE);
+	inter->bytecode = section->data;
+	inter->bytecode_size = section->size;
+
+	section = bytecode_find_section(&inter->image, SECTION_CONSTANTS);
+	if (section) {
+		inter->constants = section->data;
+		inter->constants_size = section->size;
+	}
+	if (!interpreter_verify(inter)) return false;
+	return interpreter_install_functions(inter);
+}
+
+bool interpreter_verify(interpreter* inter) {
+	verifier checker;
+	bool result;
+
+	if (!verifier_init(&checker, inter->bytecode, inter->bytecode_size, 0, inter->constants, inter->constants_size)) {
+		fputs("error : Verifier memory allocation failure\n", stderr);
+		return false;
+	}
+	result = verifier_run(&checker, bytecode_find_section(&inter->image, SECTION_FUNCTIONS), inter->image.entry);
+	verifier_del(&checker);
+
+	if (!result) fputs("error : Bytecode verification failure\n", stderr);
+	return result;
+}
+
+bool interpreter_install_functions(interpreter* inter) {
+	bytecode_section* section = bytecode_find_section(&inter->image, SECTION_FUNCTIONS);
+	rbt_node* node;
+
+	if (!section) return true;
+	if (section->size % BYTECODE_FUNCTION_ENTRY_SIZE) goto FAILURE_TABLE;
+
+	for (size_t i = 0; i < section->size; i += BYTECODE_FUNCTION_ENTRY_SIZE) {
+		uint64_t keyword = bytecode_load_u64(section->data + i);
+		uint64_t entry = bytecode_load_u64(section->data + i + 8);
+		uint64_t type = bytecode_load_u64(section->data + i + 24);
+
+		if (entry > inter->bytecode_size) goto FAILURE_TABLE;
+		if ((type != KWRD_FUNC) && (type != KWRD_MACRO)) goto FAILURE_TABLE;
+		if (rbt_search(inter->global_words, keyword)) goto FAILURE_REDEFINE;
+		node = rbt_node_new(keyword);
+		if (!node) goto FAILURE_DEFINE;
+		node->data = entry;
+		node->type = type;
+		rbt_insert(inter->global_words, node);
+	}
+	return true;
+
+FAILURE_TABLE:
+	fputs("error : Invalid function table\n", stderr);
+	return false;
+FAILURE_REDEFINE:
+	fputs("error : Redefined keyword\n", stderr);
+	return false;
+FAILURE_DEFINE:
+	fputs("error : Definition failure\n", stderr);
+	return false;
 }
 
 bool interpreter_run(interpreter* inter) {
-	uint8_t* code;
+	return interpreter_execute(inter, inter->image.entry, inter->bytecode_size);
+}
+
+uint64_t interpreter_operand(interpreter* inter, size_t* index, uint8_t op) {
+	size_t width = opcode_operand_size(op);
+	const uint8_t* operand = inter->bytecode + *index + 1;
+
+	*index += width;
+	if (width == 8) return bytecode_load_u64(operand);
+	if (opcode_is_relative(op)) return *index + 1 + bytecode_load_signed(operand, width);
+	if (opcode_is_signed(op)) return bytecode_load_signed(operand, width);
+	return bytecode_load_width(operand, width);
+}
 
-	for (size_t index = 0; index < inter->bytecode_size; index++) {
+bool interpreter_execute(interpreter* inter, size_t begin, size_t end) {
+	const uint8_t* code = inter->bytecode + begin;
+
+	for (size_t index = begin; index < end; index++) {
 		code = inter->bytecode + index;
 		switch (*code) {
-			case OP_VALUE: {
+			case OP_VALUE:
+			case OP_VALUE_8:
+			case OP_VALUE_16:
+			case OP_VALUE_32: {
 				value v;
-				for (int i = 0; i < 8; i++) {
-					v.bytes[i] = inter->bytecode[++index];
-				}
+				v.u = interpreter_operand(inter, &index, *code);
+				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
+			} break;
+			case OP_VALUES:
+			case OP_VALUES_8:
+			case OP_VALUES_16:
+			case OP_VALUES_32: {
+				size_t count = interpreter_operand(inter, &index, *code);
+				if (!interpreter_push_values(inter, inter->bytecode + index + 1, count)) goto FAILURE_STACK;
+				index += count * sizeof(value);
+			} break;
+			case OP_VALUE_ZERO:
+			case OP_VALUE_ONE: {
+				value v;
+				v.u = *code == OP_VALUE_ONE;
 				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
 			} break;
-			case OP_IF: {
+			case OP_IF:
+			case OP_IF_8:
+			case OP_IF_16:
+			case OP_IF_32: {
 				value pos;
 				value v;
-				for (int i = 0; i < 8; i++) {
-					pos.bytes[i] = inter->bytecode[++index];
-				}
+				pos.u = interpreter_operand(inter, &index, *code);
 				if (!interpreter_pop(inter, &v)) goto FAILURE_STACK;
 				if (!v.u) index = pos.u - 1;
 			} break;
-			case OP_JUMP: {
+			case OP_JUMP:
+			case OP_JUMP_8:
+			case OP_JUMP_16:
+			case OP_JUMP_32: {
 				value pos;
-				for (int i = 0; i < 8; i++) {
-					pos.bytes[i] = inter->bytecode[++index];
-				}
+				pos.u = interpreter_operand(inter, &index, *code);
 				index = pos.u - 1;
 			} break;
+			case OP_DATA:
+			case OP_DATA_8:
+			case OP_DATA_16:
+			case OP_DATA_32: {
+				value v;
+				size_t offset = interpreter_operand(inter, &index, *code);
+				v.p = (uint64_t*) (inter->constants + offset + 8);
+				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
+				v.u = bytecode_load_u64(inter->constants + offset);
+				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
+			} break;
+			case OP_PUSHDATA:
+			case OP_PUSHDATA_8:
+			case OP_PUSHDATA_16:
+			case OP_PUSHDATA_32: {
+				value v;
+				size_t offset = interpreter_operand(inter, &index, *code);
+				size_t length = bytecode_load_u64(inter->constants + offset);
+				for (size_t i = length; i > 0; i--) {
+					v.u = bytecode_load_u64(inter->constants + offset + i * 8);
+					if (!interpreter_push(inter, v)) goto FAILURE_STACK;
+				}
+				v.u = length;
+				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
+			} break;
 			case OP_SWITCH: {
 				value v;
 				if (!interpreter_pop(inter, &v)) goto FAILURE_STACK;
-				deque_push_back(value, &inter->switch_stack, v);
+				if (!deque_push_back(value, &inter->switch_stack, v)) goto FAILURE_STACK;
 			} break;
 			case OP_CASE: {
 				value v;
+				if (!inter->switch_stack.size) goto FAILURE_SWITCH;
 				v = *deque_back(value, &inter->switch_stack);
 				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
 			} break;
 			case OP_ENDSWITCH: {
-				deque_pop_back(value, &inter->switch_stack);
+				if (!deque_pop_back(value, &inter->switch_stack)) goto FAILURE_SWITCH;
 			} break;
-			case OP_FUNC: {
+			case OP_FUNC:
+			case OP_FUNC_8:
+			case OP_FUNC_16:
+			case OP_FUNC_32: {
 				value kwrd;
 				value pos;
 				if (!interpreter_pop(inter, &kwrd)) goto FAILURE_STACK;
@@ -123,16 +314,17 @@ bool interpreter_run(interpreter* inter) {
 				node = rbt_node_new(kwrd.u);
 				if (!node) goto FAILURE_DEFINE;
 
-				node->data = index + 9;
+				pos.u = interpreter_operand(inter, &index, *code);
+				node->data = index + 1;
 				node->type = KWRD_FUNC;
 				rbt_insert(inter->global_words, node);
 
-				for (int i = 0; i < 8; i++) {
-					pos.bytes[i] = inter->bytecode[++index];
-				}
 				index = pos.u - 1;
 			} break;
-			case OP_MACRO: {
+			case OP_MACRO:
+			case OP_MACRO_8:
+			case OP_MACRO_16:
+			case OP_MACRO_32: {
 				value kwrd;
 				value pos;
 				if (!interpreter_pop(inter, &kwrd)) goto FAILURE_STACK;
@@ -142,17 +334,34 @@ bool interpreter_run(interpreter* inter) {
 				node = rbt_node_new(kwrd.u);
 				if (!node) goto FAILURE_DEFINE;
 
-				node->data = index + 9;
+				pos.u = interpreter_operand(inter, &index, *code);
+				node->data = index + 1;
 				node->type = KWRD_MACRO;
 				rbt_insert(inter->global_words, node);
 
-				for (int i = 0; i < 8; i++) {
-					pos.bytes[i] = inter->bytecode[++index];
-				}
 				index = pos.u - 1;
 			} break;
+			case OP_ALIAS:
+			case OP_ALIAS_8:
+			case OP_ALIAS_16:
+			case OP_ALIAS_32: {
+				value kwrd;
+				value pos;
+				if (!interpreter_pop(inter, &kwrd)) goto FAILURE_STACK;
+				rbt_node* node = NULL;
+				node = rbt_search(inter->global_words, kwrd.u);
+				if (node) goto FAILURE_REDEFINE;
+				node = rbt_node_new(kwrd.u);
+				if (!node) goto FAILURE_DEFINE;
+
+				pos.u = interpreter_operand(inter, &index, *code);
+				node->data = pos.u;
+				node->type = KWRD_FUNC;
+				rbt_insert(inter->global_words, node);
+			} break;
 			case OP_RETURN: {
 				if (inter->call_stack.size < 1) goto FAILURE_CALL;
+				scratch_leave(&inter->scratch_region, inter->call_stack.size);
 				size_t pos = *deque_back(size_t, &inter->call_stack);
 				if (!deque_pop_back(size_t, &inter->call_stack)) goto FAILURE_CALL;
 				rbt* local_words = *deque_back(cctl_ptr(rbt), &inter->local_words_stack);
@@ -196,13 +405,14 @@ bool interpreter_run(interpreter* inter) {
 				}
 				else goto FAILURE_INVALID;
 			} break;
-			case OP_CALL: {
+			case OP_CALL:
+			case OP_CALL_8:
+			case OP_CALL_16:
+			case OP_CALL_32: {
 				value kwrd;
 				rbt* local_words = NULL;
 				rbt_node* node = NULL;
-				for (int i = 0; i < 8; i++) {
-					kwrd.bytes[i] = inter->bytecode[++index];
-				}
+				kwrd.u = interpreter_operand(inter, &index, *code);
 				node = rbt_search(inter->global_words, kwrd.u);
 				if (!node) {
 					if (inter->local_words_stack.size > 0) {
@@ -638,8 +848,10 @@ bool interpreter_run(interpreter* inter) {
 			case OP_ALLOC: {
 				value v;
 				if (!interpreter_pop(inter, &v)) goto FAILURE_STACK;
+				size_t size = v.u * sizeof(value);
 				if (!v.u) v.p = NULL;
-				else v.p = malloc(v.u * sizeof(value));
+				else v.p = malloc(size);
+				if (inter->track_allocations && v.p && !interpreter_track_allocation(inter, v.p, size)) goto FAILURE_STACK;
 				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
 			} break;
 			case OP_RESIZE: {
@@ -648,6 +860,7 @@ bool interpreter_run(interpreter* inter) {
 				if (!interpreter_pop(inter, &a)) goto FAILURE_STACK;
 				if (!b.u) free(a.p);
 				else a.p = realloc((void*) a.u, b.u * sizeof(value));
+				if (inter->track_allocations && b.u && a.p && !interpreter_track_allocation(inter, a.p, b.u * sizeof(value))) goto FAILURE_STACK;
 				if (!interpreter_push(inter, a)) goto FAILURE_STACK;
 			} break;
 			case OP_FREE: {
@@ -667,6 +880,14 @@ bool interpreter_run(interpreter* inter) {
 				if (!interpreter_pop(inter, &a)) goto FAILURE_STACK;
 				*b.p = a.u;
 			} break;
+			case OP_SALLOC: {
+				value v;
+				if (!interpreter_pop(inter, &v)) goto FAILURE_STACK;
+				if (!scratch_enter(&inter->scratch_region, inter->call_stack.size)) goto FAILURE_STACK;
+				v.p = (uint64_t*) scratch_alloc(&inter->scratch_region, v.u);
+				if (!v.p) goto FAILURE_STACK;
+				if (!interpreter_push(inter, v)) goto FAILURE_STACK;
+			} break;
 			case OP_STOF: {
 				value v;
 				if (!interpreter_pop(inter, &v)) goto FAILURE_STACK;
@@ -793,7 +1014,7 @@ bool interpreter_run(interpreter* inter) {
 					size_t rc = c32rtomb(out, (char32_t) v.u, &(inter->convert_state));
 					if (rc == -1) {
 						fputs("error : Unicode encoding failure\n", stderr);
-						return false;
+						goto FAILURE;
 					}
 					out[rc] = 0;
 					fputs(out, stdout);
@@ -817,14 +1038,12 @@ bool interpreter_run(interpreter* inter) {
 			case OP_SHOW: {
 				printf("[%zu] [ ", inter->data_stack.size);
 				for (size_t i = 0; i < inter->data_stack.size; i++) {
-					printf("%" PRId64 " ", (*deque_at(value, &inter->data_stack, i)).i);
+					printf("%" PRId64 " ", (*vector_at(value, &inter->data_stack, i)).i);
 				}
 				printf("]\n");
 			} break;
 			default: {
-				fprintf(stderr, "\'%u\'\n", *code);
-				fputs("error : Invalid operation code\n", stderr);
-				return false;
+				__builtin_unreachable();
 			}
 		}
 	}
@@ -832,41 +1051,102 @@ bool interpreter_run(interpreter* inter) {
 
 FAILURE_STACK:
 	fputs("error : Stack memory error\n", stderr);
-	return false;
+	goto FAILURE;
 FAILURE_INVALID:
 	fputs("error : Invalid keyword\n", stderr);
-	return false;
+	goto FAILURE;
 FAILURE_UNDEFINED:
 	fputs("error : Undefined keyword\n", stderr);
-	return false;
+	goto FAILURE;
 FAILURE_REDEFINE:
 	fputs("error : Redefined keyword\n", stderr);
-	return false;
+	goto FAILURE;
 FAILURE_DEFINE:
 	fputs("error : Definition failure\n", stderr);
-	return false;
+	goto FAILURE;
 FAILURE_CALL:
 	fputs("error : Call stack error\n", stderr);
-	return false;
+	goto FAILURE;
+FAILURE_SWITCH:
+	fputs("error : Switch stack error\n", stderr);
+	goto FAILURE;
 FAILURE_STDIN:
 	fputs("error: Input error\n", stderr);
+FAILURE:
+	interpreter_report(inter, code - inter->bytecode);
 	return false;
 }
 
+void interpreter_report(interpreter* inter, size_t pos) {
+	bytecode_section* debug = bytecode_find_section(&inter->image, SECTION_DEBUG);
+	const char* file;
+	const char* name = NULL;
+	uint64_t line;
+	uint64_t column;
+	size_t index = pos;
+
+	if (!debug) return;
+	if (!bytecode_decompress_section(debug)) return;
+	if (!bytecode_find_line(debug, pos, &file, &line, &column)) return;
+
+	switch (inter->bytecode[pos]) {
+		case OP_CALL:
+		case OP_CALL_8:
+		case OP_CALL_16:
+		case OP_CALL_32: {
+			name = bytecode_find_keyword(debug, interpreter_operand(inter, &index, inter->bytecode[pos]));
+		} break;
+	}
+	if (name) fprintf(stderr, console_yellow console_bold "%s" console_reset " ", name);
+	fprintf(stderr, "in line %" PRIu64 ", column %" PRIu64 "\n", line, column);
+	fprintf(stderr, "from file " console_yellow console_bold "%s" console_reset "\n", file);
+}
+
 bool interpreter_pop(interpreter* inter, value* v) {
 	if (!inter->data_stack.size) {
 		fputs("error : Stack underflow\n", stderr);
 		return false;
 	}
-	*v = *deque_back(value, &inter->data_stack);
-	deque_pop_back(value, &inter->data_stack);
+	*v = *vector_back(value, &inter->data_stack);
+	vector_pop_back(value, &inter->data_stack);
 	return true;
 }
 
 bool interpreter_push(interpreter* inter, value v) {
-	if (!deque_push_back(value, &inter->data_stack, v)) {
+	if (!vector_push_back(value, &inter->data_stack, v)) {
 		fputs("error : Stack memory allocation failure\n", stderr);
 		return false;
 	}
 	return true;
+}
+
+bool interpreter_push_values(interpreter* inter, const uint8_t* data, size_t count) {
+	size_t size = inter->data_stack.size;
+	if (!vector_resize(value, &inter->data_stack, size + count)) {
+		fputs("error : Stack memory allocation failure\n", stderr);
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		vector_at(value, &inter->data_stack, size + i)->u = bytecode_load_u64(data + i * sizeof(value));
+	}
+	return true;
+}
+
+bool interpreter_track_allocation(interpreter* inter, uint64_t* address, size_t size) {
+	allocation block = {address, size};
+	return vector_push_back(allocation, &inter->allocations, block);
+}
+
+bool interpreter_owns_address(interpreter* inter, value v) {
+	uintptr_t address = (uintptr_t) v.p;
+
+	if (inter->constants && (address >= (uintptr_t) inter->constants) && (address <= (uintptr_t) (inter->constants + inter->constants_size))) return true;
+	for (size_t i = 0; i < inter->allocations.size; i++) {
+		allocation* block = vector_at(allocation, &inter->allocations, i);
+		if ((address >= (uintptr_t) block->address) && (address <= (uintptr_t) block->address + block->size)) return true;
+	}
+	for (scratch_chunk* chunk = inter->scratch_region.head; chunk; chunk = chunk->next) {
+		if ((address >= (uintptr_t) chunk->data) && (address <= (uintptr_t) (chunk->data + chunk->size))) return true;
+	}
+	return false;
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "interpreter_cctl_define.h"
 
+vector_imp_c(value);
+vector_imp_c(allocation);
 deque_imp_c(value);
 deque_imp_c(size_t);
 deque_imp_c(cctl_ptr(rbt));
\ No newline at end of file
@@ -10,7 +10,10 @@ int main(int argc, char* argv[]) {
 		fputs("error : No input files\n", stderr);
 		return 2;
 	}
-	interpreter_load_code(&inter, argv[1]);
+	if (!interpreter_load_code(&inter, argv[1])) {
+		interpreter_del(&inter);
+		return 3;
+	}
 	interpreter_run(&inter);
 
 	interpreter_del(&inter);
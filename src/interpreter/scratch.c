@@ -0,0 +1,81 @@
+#include "scratch.h"
+
+void scratch_init(scratch* s) {
+	s->head = NULL;
+	s->current = NULL;
+	s->marks = NULL;
+	s->mark_count = 0;
+	s->mark_capacity = 0;
+}
+
+void scratch_del(scratch* s) {
+	scratch_chunk* chunk = s->head;
+	while (chunk) {
+		scratch_chunk* next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	free(s->marks);
+	scratch_init(s);
+}
+
+value* scratch_alloc(scratch* s, size_t count) {
+	scratch_chunk* chunk = s->current;
+	scratch_chunk* next;
+	value* result;
+
+	if (!count) count = 1;
+	if (count > (SIZE_MAX - sizeof(scratch_chunk)) / sizeof(value)) return NULL;
+
+	if (!chunk || (chunk->size - chunk->used < count)) {
+		next = chunk ? chunk->next : s->head;
+		if (!next || (next->size < count)) {
+			size_t size = (count > SCRATCH_CHUNK_CELLS) ? count : SCRATCH_CHUNK_CELLS;
+			scratch_chunk* new_chunk = (scratch_chunk*) malloc(sizeof(scratch_chunk) + size * sizeof(value));
+			if (!new_chunk) return NULL;
+			new_chunk->size = size;
+			new_chunk->next = next;
+			if (chunk) chunk->next = new_chunk;
+			else s->head = new_chunk;
+			next = new_chunk;
+		}
+		next->used = 0;
+		chunk = next;
+		s->current = chunk;
+	}
+
+	result = chunk->data + chunk->used;
+	chunk->used += count;
+	return result;
+}
+
+bool scratch_enter(scratch* s, size_t depth) {
+	scratch_mark* mark;
+
+	if (s->mark_count && (s->marks[s->mark_count - 1].depth == depth)) return true;
+	if (s->mark_count == s->mark_capacity) {
+		size_t capacity = s->mark_capacity ? s->mark_capacity * 2 : 16;
+		scratch_mark* marks = (scratch_mark*) realloc(s->marks, capacity * sizeof(scratch_mark));
+		if (!marks) return false;
+		s->marks = marks;
+		s->mark_capacity = capacity;
+	}
+
+	mark = s->marks + s->mark_count++;
+	mark->depth = depth;
+	mark->chunk = s->current;
+	mark->used = s->current ? s->current->used : 0;
+	return true;
+}
+
+void scratch_leave(scratch* s, size_t depth) {
+	scratch_mark* mark;
+
+	if (!s->mark_count) return;
+	mark = s->marks + s->mark_count - 1;
+	if (mark->depth != depth) return;
+
+	s->current = mark->chunk;
+	if (mark->chunk) mark->chunk->used = mark->used;
+	s->mark_count--;
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "verifier.h"
+
+bool verifier_init(verifier* v, const uint8_t* code, size_t code_size, size_t base, const uint8_t* constants, size_t constants_size) {
+	v->code = code;
+	v->code_size = code_size;
+	v->base = base;
+	v->constants = constants;
+	v->constants_size = constants_size;
+	v->previous = (uint8_t*) calloc(code_size + 1, sizeof(uint8_t));
+	return v->previous != NULL;
+}
+
+void verifier_del(verifier* v) {
+	free(v->previous);
+	v->previous = NULL;
+}
+
+bool verifier_opcode_valid(uint8_t op) {
+	return (op > OP_NONE) && (op <= OP_SHOW);
+}
+
+uint8_t verifier_branch_kind(uint8_t op) {
+	switch (op) {
+		case OP_IF:
+		case OP_IF_8:
+		case OP_IF_16:
+		case OP_IF_32: {
+			return OP_IF;
+		}
+		case OP_JUMP:
+		case OP_JUMP_8:
+		case OP_JUMP_16:
+		case OP_JUMP_32: {
+			return OP_JUMP;
+		}
+		case OP_FUNC:
+		case OP_FUNC_8:
+		case OP_FUNC_16:
+		case OP_FUNC_32: {
+			return OP_FUNC;
+		}
+		case OP_MACRO:
+		case OP_MACRO_8:
+		case OP_MACRO_16:
+		case OP_MACRO_32: {
+			return OP_MACRO;
+		}
+		case OP_ALIAS:
+		case OP_ALIAS_8:
+		case OP_ALIAS_16:
+		case OP_ALIAS_32: {
+			return OP_ALIAS;
+		}
+	}
+	return OP_NONE;
+}
+
+bool verifier_boundary(verifier* v, size_t pos) {
+	if (pos > v->code_size) return false;
+	return !pos || v->previous[pos];
+}
+
+bool verifier_operand(verifier* v, size_t pos, uint64_t* operand, size_t* next) {
+	uint8_t op = v->code[pos];
+	size_t width = opcode_operand_size(op);
+	const uint8_t* data = v->code + pos + 1;
+
+	if (width >= v->code_size - pos) return false;
+	*next = pos + 1 + width;
+
+	if (width == 8) *operand = bytecode_load_u64(data);
+	else if (opcode_is_relative(op)) *operand = *next + bytecode_load_signed(data, width);
+	else if (opcode_is_signed(op)) *operand = bytecode_load_signed(data, width);
+	else *operand = bytecode_load_width(data, width);
+
+	switch (op) {
+		case OP_VALUES:
+		case OP_VALUES_8:
+		case OP_VALUES_16:
+		case OP_VALUES_32: {
+			if (*operand > (v->code_size - *next) / sizeof(value)) return false;
+			*next += *operand * sizeof(value);
+		} break;
+	}
+	return true;
+}
+
+bool verifier_constant_space(verifier* v, uint64_t offset, size_t unit) {
+	if (v->constants_size < sizeof(value)) return false;
+	if (offset > v->constants_size - sizeof(value)) return false;
+	return bytecode_load_u64(v->constants + offset) <= (v->constants_size - offset - sizeof(value)) / unit;
+}
+
+bool verifier_constant(verifier* v, uint8_t op, uint64_t offset) {
+	switch (op) {
+		case OP_DATA:
+		case OP_DATA_8:
+		case OP_DATA_16:
+		case OP_DATA_32: {
+			return verifier_constant_space(v, offset, 1);
+		}
+		case OP_PUSHDATA:
+		case OP_PUSHDATA_8:
+		case OP_PUSHDATA_16:
+		case OP_PUSHDATA_32: {
+			return verifier_constant_space(v, offset, sizeof(value));
+		}
+	}
+	return true;
+}
+
+bool verifier_scan(verifier* v) {
+	size_t pos = 0;
+	size_t next;
+	uint64_t operand;
+
+	while (pos < v->code_size) {
+		uint8_t op = v->code[pos];
+		if (!verifier_opcode_valid(op)) goto FAILURE_OPCODE;
+		if (!verifier_operand(v, pos, &operand, &next)) goto FAILURE_OPERAND;
+		if (!verifier_constant(v, op, operand)) goto FAILURE_CONSTANT;
+		v->previous[next] = op;
+		pos = next;
+	}
+	return true;
+
+FAILURE_OPCODE:
+	fprintf(stderr, "\'%u\' at %zu\n", v->code[pos], pos);
+	fputs("error : Invalid operation code\n", stderr);
+	return false;
+FAILURE_OPERAND:
+	fprintf(stderr, "\'%u\' at %zu\n", v->code[pos], pos);
+	fputs("error : Truncated operand\n", stderr);
+	return false;
+FAILURE_CONSTANT:
+	fprintf(stderr, "\'%u\' at %zu\n", v->code[pos], pos);
+	fputs("error : Invalid constant data reference\n", stderr);
+	return false;
+}
+
+bool verifier_check_branches(verifier* v) {
+	size_t pos = 0;
+	size_t next;
+	size_t switches = 0;
+	uint64_t target;
+
+	while (pos < v->code_size) {
+		uint8_t kind = verifier_branch_kind(v->code[pos]);
+		verifier_operand(v, pos, &target, &next);
+		switch (v->code[pos]) {
+			case OP_SWITCH: {
+				switches++;
+			} break;
+			case OP_CASE: {
+				if (!switches) goto FAILURE_SWITCH;
+			} break;
+			case OP_ENDSWITCH: {
+				if (!switches) goto FAILURE_SWITCH;
+				switches--;
+			} break;
+		}
+		if (kind != OP_NONE) {
+			if (target < v->base) goto FAILURE_TARGET;
+			target -= v->base;
+			if (!verifier_boundary(v, target)) goto FAILURE_TARGET;
+			switch (kind) {
+				case OP_FUNC: {
+					if ((target <= pos) || (v->previous[target] != OP_RETURN)) goto FAILURE_BODY;
+				} break;
+				case OP_MACRO: {
+					if ((target <= pos) || (v->previous[target] != OP_ENDMACRO)) goto FAILURE_BODY;
+				} break;
+				case OP_ALIAS: {
+					if (target >= v->code_size) goto FAILURE_TARGET;
+				} break;
+			}
+		}
+		pos = next;
+	}
+	if (switches) goto FAILURE_SWITCH;
+	return true;
+
+FAILURE_TARGET:
+	fprintf(stderr, "\'%u\' at %zu\n", v->code[pos], pos);
+	fputs("error : Invalid branch target\n", stderr);
+	return false;
+FAILURE_BODY:
+	fprintf(stderr, "\'%u\' at %zu\n", v->code[pos], pos);
+	fputs("error : Invalid definition body\n", stderr);
+	return false;
+FAILURE_SWITCH:
+	if (pos < v->code_size) fprintf(stderr, "\'%u\' at %zu\n", v->code[pos], pos);
+	fputs("error : Unbalanced switch\n", stderr);
+	return false;
+}
+
+bool verifier_check_function(verifier* v, uint64_t entry, uint64_t end, uint64_t type) {
+	if ((entry >= end) || !verifier_boundary(v, entry) || !verifier_boundary(v, end)) return false;
+	if (type == KWRD_FUNC) return v->previous[end] == OP_RETURN;
+	if (type == KWRD_MACRO) return v->previous[end] == OP_ENDMACRO;
+	return false;
+}
+
+bool verifier_check_functions(verifier* v, bytecode_section* table) {
+	if (!table) return true;
+	if (table->size % BYTECODE_FUNCTION_ENTRY_SIZE) goto FAILURE_TABLE;
+
+	for (size_t i = 0; i < table->size; i += BYTECODE_FUNCTION_ENTRY_SIZE) {
+		uint64_t entry = bytecode_load_u64(table->data + i + 8);
+		uint64_t end = bytecode_load_u64(table->data + i + 16);
+		uint64_t type = bytecode_load_u64(table->data + i + 24);
+		if (!verifier_check_function(v, entry, end, type)) goto FAILURE_TABLE;
+	}
+	return true;
+
+FAILURE_TABLE:
+	fputs("error : Invalid function table\n", stderr);
+	return false;
+}
+
+bool verifier_run(verifier* v, bytecode_section* table, uint64_t entry) {
+	if (!verifier_scan(v)) return false;
+	if (!verifier_check_branches(v)) return false;
+	if (!verifier_check_functions(v, table)) return false;
+	if (!verifier_boundary(v, entry)) {
+		fputs("error : Invalid entry point\n", stderr);
+		return false;
+	}
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "linker.h"
+
+bool linker_add_object(compiler* comp, char* filename) {
+	bytecode_image image;
+	bytecode_section* code;
+	bytecode_section* constants;
+	uint8_t* data = NULL;
+	size_t size;
+	size_t* map = NULL;
+	size_t code_base = comp->bytecode.size;
+	size_t constant_base = comp->constants.size;
+
+	if (!bytecode_read_file(filename, &data, &size)) goto FAILURE_READ;
+	if (!bytecode_parse(&image, data, size)) goto FAILURE_OBJECT;
+	if (!(image.flags & BYTECODE_FLAG_OBJECT)) goto FAILURE_OBJECT;
+	code = bytecode_find_section(&image, SECTION_CODE);
+	constants = bytecode_find_section(&image, SECTION_CONSTANTS);
+
+	map = (size_t*) malloc((image.keyword_count + 1) * sizeof(size_t));
+	if (!map) goto FAILURE_ALLOC;
+	if (!linker_map_symbols(comp, bytecode_find_section(&image, SECTION_SYMBOLS), image.keyword_count, map)) goto FAILURE_OBJECT;
+
+	if (!vector_resize(uint8_t, &comp->bytecode, code_base + code->size)) goto FAILURE_ALLOC;
+	if (code->size) memcpy(vector_at(uint8_t, &comp->bytecode, code_base), code->data, code->size);
+	if (constants && constants->size) {
+		if (constants->size % sizeof(value)) goto FAILURE_OBJECT;
+		if (!vector_resize(uint8_t, &comp->constants, constant_base + constants->size)) goto FAILURE_ALLOC;
+		memcpy(vector_at(uint8_t, &comp->constants, constant_base), constants->data, constants->size);
+	}
+
+	if (!linker_relocate_code(comp, code_base, constant_base, map, image.keyword_count)) goto FAILURE_OBJECT;
+	if (!linker_add_keyword_sites(comp, bytecode_find_section(&image, SECTION_RELOCATIONS), code_base, map, image.keyword_count)) goto FAILURE_OBJECT;
+	if (!linker_add_functions(comp, bytecode_find_section(&image, SECTION_FUNCTIONS), code_base, map, image.keyword_count)) goto FAILURE_OBJECT;
+
+	free(map);
+	free(data);
+	return true;
+
+FAILURE_READ:
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename);
+	fputs("error : File reading failure\n", stderr);
+	return false;
+FAILURE_ALLOC:
+	free(map);
+	free(data);
+	fputs("error : Object memory allocation failure\n", stderr);
+	return false;
+FAILURE_OBJECT:
+	free(map);
+	free(data);
+	fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", filename);
+	fputs("error : Invalid object file\n", stderr);
+	return false;
+}
+
+bool linker_map_symbols(compiler* comp, bytecode_section* section, uint64_t count, size_t* map) {
+	size_t pos = 0;
+	dict_entry* word;
+
+	if (!count) return true;
+	if (!section) return false;
+	if (section->size && section->data[section->size - 1]) return false;
+
+	for (uint64_t i = 1; i <= count; i++) {
+		const char* name = (const char*) section->data + pos;
+		if (pos >= section->size) return false;
+		pos += strlen(name) + 1;
+
+		word = dict_find(&comp->dictionary, name);
+		if (word) {
+			if (word->type != WTT_KWRD) return false;
+		}
+		else {
+			word = dict_insert(&comp->dictionary, name, WTT_KWRD);
+			if (!word) return false;
+			word->data.u = ++comp->dictionary_keyword_count;
+		}
+		map[i] = word->data.u;
+	}
+	return pos == section->size;
+}
+
+bool linker_relocate_code(compiler* comp, size_t code_base, size_t constant_base, size_t* map, uint64_t count) {
+	size_t pos = code_base;
+	size_t size = comp->bytecode.size;
+	value operand;
+
+	while (pos < size) {
+		uint8_t* code = vector_at(uint8_t, &comp->bytecode, pos);
+		uint8_t op = *code;
+		if (!instruction_has_operand(op)) {
+			pos++;
+			continue;
+		}
+		if (pos + 9 > size) return false;
+
+		memcpy(operand.bytes, code + 1, 8);
+		if (instruction_is_branch(op)) {
+			if (operand.u > size - code_base) return false;
+			operand.u += code_base;
+		}
+		else if ((op == OP_DATA) || (op == OP_PUSHDATA)) {
+			operand.u += constant_base;
+		}
+		else if (op == OP_CALL) {
+			if (!operand.u || (operand.u > count)) return false;
+			operand.u = map[operand.u];
+		}
+		memcpy(code + 1, operand.bytes, 8);
+		pos += 9;
+	}
+	return true;
+}
+
+bool linker_add_keyword_sites(compiler* comp, bytecode_section* section, size_t code_base, size_t* map, uint64_t count) {
+	value operand;
+
+	if (!section) return true;
+	if (section->size % sizeof(uint64_t)) return false;
+
+	for (size_t i = 0; i < section->size; i += sizeof(uint64_t)) {
+		size_t site = code_base + bytecode_load_u64(section->data + i);
+		uint8_t* code;
+		if (site + 9 > comp->bytecode.size) return false;
+		code = vector_at(uint8_t, &comp->bytecode, site);
+		if (*code != OP_VALUE) return false;
+
+		memcpy(operand.bytes, code + 1, 8);
+		if (!operand.u || (operand.u > count)) return false;
+		operand.u = map[operand.u];
+		memcpy(code + 1, operand.bytes, 8);
+
+		if (!vector_push_back(size_t, &comp->keyword_sites, site)) return false;
+	}
+	return true;
+}
+
+bool linker_add_functions(compiler* comp, bytecode_section* section, size_t code_base, size_t* map, uint64_t count) {
+	function_data func;
+
+	if (!section) return true;
+	if (section->size % BYTECODE_FUNCTION_ENTRY_SIZE) return false;
+
+	for (size_t i = 0; i < section->size; i += BYTECODE_FUNCTION_ENTRY_SIZE) {
+		uint64_t keyword = bytecode_load_u64(section->data + i);
+		uint64_t begin = bytecode_load_u64(section->data + i + 8);
+		uint64_t end = bytecode_load_u64(section->data + i + 16);
+		uint64_t type = bytecode_load_u64(section->data + i + 24);
+
+		if (!keyword || (keyword > count)) return false;
+		if ((begin >= end) || (end > comp->bytecode.size - code_base)) return false;
+
+		func.keyword = map[keyword];
+		func.ctrl = ((type & ~BYTECODE_FUNCTION_TOPLEVEL) == KWRD_MACRO) ? CTRL_MACRO : CTRL_FUNC;
+		func.begin = code_base + begin;
+		func.end = code_base + end;
+		func.toplevel = type & BYTECODE_FUNCTION_TOPLEVEL;
+		func.installed = false;
+		if (!vector_push_back(function_data, &comp->function_vector, func)) return false;
+	}
+	return true;
+}
+
+bool linker_link(compiler* comp, char* output_filename) {
+	if (!compiler_optimize(comp)) {
+		fputs("error : Optimization failure\n", stderr);
+		return false;
+	}
+	if (!compiler_save_code(comp, output_filename)) {
+		fputs("error : File saving failure\n", stderr);
+		return false;
+	}
+	return true;
+}
\ No newline at end of file
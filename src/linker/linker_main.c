@@ -0,0 +1,48 @@
+#include <stdio.h>
+
+#include "linker.h"
+
+int main(int argc, char* argv[]) {
+
+	compiler comp;
+	char* output_filename = "out.sabre";
+	int input_count = 0;
+	if (!compiler_init(&comp)) return 1;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-o")) {
+			if (++i >= argc) {
+				fputs("error : No output file\n", stderr);
+				return 2;
+			}
+			output_filename = argv[i];
+		}
+		else if (!strncmp(argv[i], "--", 2)) {
+			if (!compiler_parse_option(&comp, argv[i] + 2)) {
+				fprintf(stderr, console_yellow console_bold "%s" console_reset "\n", argv[i]);
+				fputs("error : Invalid option\n", stderr);
+				return 2;
+			}
+		}
+		else {
+			if (!linker_add_object(&comp, argv[i])) {
+				fputs("error : Linking failure\n", stderr);
+				return 3;
+			}
+			input_count++;
+		}
+	}
+
+	if (!input_count) {
+		fputs("error : No input files\n", stderr);
+		return 2;
+	}
+	if (!linker_link(&comp, output_filename)) {
+		fputs("error : Linking failure\n", stderr);
+		return 3;
+	}
+
+	compiler_del(&comp);
+
+	return 0;
+}
\ No newline at end of file
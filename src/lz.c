@@ -0,0 +1,114 @@
+#include "lz.h"
+
+size_t lz_bound(size_t size) {
+	return size + size / 255 + 16;
+}
+
+uint32_t lz_hash(const uint8_t* p) {
+	uint32_t x;
+	memcpy(&x, p, sizeof(uint32_t));
+	return (x * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+uint8_t* lz_write_length(uint8_t* op, size_t length) {
+	while (length >= 255) {
+		*op++ = 255;
+		length -= 255;
+	}
+	*op++ = length;
+	return op;
+}
+
+uint8_t* lz_write_sequence(uint8_t* op, const uint8_t* literals, size_t literal_length, size_t offset, size_t match_length) {
+	uint8_t* token = op++;
+	size_t match_code = match_length ? match_length - LZ_MIN_MATCH : 0;
+
+	*token = ((literal_length < LZ_RUN_MASK ? literal_length : LZ_RUN_MASK) << 4) | (match_code < LZ_RUN_MASK ? match_code : LZ_RUN_MASK);
+	if (literal_length >= LZ_RUN_MASK) op = lz_write_length(op, literal_length - LZ_RUN_MASK);
+	memcpy(op, literals, literal_length);
+	op += literal_length;
+	if (!match_length) return op;
+
+	*op++ = offset & 0xff;
+	*op++ = offset >> 8;
+	if (match_code >= LZ_RUN_MASK) op = lz_write_length(op, match_code - LZ_RUN_MASK);
+	return op;
+}
+
+size_t lz_compress(const uint8_t* in, size_t size, uint8_t* out) {
+	size_t* table = (size_t*) calloc((size_t) 1 << LZ_HASH_BITS, sizeof(size_t));
+	const uint8_t* end = in + size;
+	const uint8_t* anchor = in;
+	const uint8_t* ip = in;
+	uint8_t* op = out;
+
+	if (!table) return 0;
+
+	while (ip + LZ_MIN_MATCH <= end) {
+		uint32_t hash = lz_hash(ip);
+		size_t candidate = table[hash];
+		size_t pos = ip - in + 1;
+		table[hash] = pos;
+
+		if (candidate && (pos - candidate <= LZ_MAX_OFFSET) && !memcmp(in + candidate - 1, ip, LZ_MIN_MATCH)) {
+			const uint8_t* match = in + candidate - 1;
+			size_t length = LZ_MIN_MATCH;
+			while ((ip + length < end) && (match[length] == ip[length])) length++;
+			op = lz_write_sequence(op, anchor, ip - anchor, ip - match, length);
+			ip += length;
+			anchor = ip;
+		}
+		else ip++;
+	}
+	op = lz_write_sequence(op, anchor, end - anchor, 0, 0);
+
+	free(table);
+	return op - out;
+}
+
+bool lz_read_length(const uint8_t** ip, const uint8_t* end, size_t* length) {
+	uint8_t byte;
+	do {
+		if (*ip >= end) return false;
+		byte = *(*ip)++;
+		*length += byte;
+	} while (byte == 255);
+	return true;
+}
+
+bool lz_decompress(const uint8_t* in, size_t size, uint8_t* out, size_t out_size) {
+	const uint8_t* ip = in;
+	const uint8_t* end = in + size;
+	uint8_t* op = out;
+	uint8_t* out_end = out + out_size;
+
+	while (ip < end) {
+		uint8_t token = *ip++;
+		size_t length = token >> 4;
+		size_t offset;
+		const uint8_t* match;
+
+		if ((length == LZ_RUN_MASK) && !lz_read_length(&ip, end, &length)) return false;
+		if ((length > (size_t) (end - ip)) || (length > (size_t) (out_end - op))) return false;
+		memcpy(op, ip, length);
+		ip += length;
+		op += length;
+		if (ip == end) break;
+
+		if (end - ip < 2) return false;
+		offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (!offset || (offset > (size_t) (op - out))) return false;
+
+		length = token & LZ_RUN_MASK;
+		if ((length == LZ_RUN_MASK) && !lz_read_length(&ip, end, &length)) return false;
+		length += LZ_MIN_MATCH;
+		if (length > (size_t) (out_end - op)) return false;
+
+		match = op - offset;
+		if (offset >= length) memcpy(op, match, length);
+		else for (size_t i = 0; i < length; i++) op[i] = match[i];
+		op += length;
+	}
+	return op == out_end;
+}
\ No newline at end of file
@@ -222,13 +222,11 @@ void rbt_delete(rbt* t, rbt_node* z) {
 }
 
 rbt_node* rbt_search_recurse(rbt* t, rbt_node* n, size_t index) {
-	rbt_node* r = NULL;
-	if (n != t->nil) {
-		if (n->index == index) return n;
-		r = rbt_search_recurse(t, n->left, index);
-		if (!r) r = rbt_search_recurse(t, n->right, index);
+	while (n != t->nil) {
+		if (index == n->index) return n;
+		n = index < n->index ? n->left : n->right;
 	}
-	return r;
+	return NULL;
 }
 
 extern inline rbt_node* rbt_search(rbt* t, size_t index) {